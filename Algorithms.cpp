@@ -1,204 +1,384 @@
 // email:shmuel.benatar@msmail.ariel.ac.il
 #include "Algorithms.h"
 #include "Graph.h"
+#include "CSRGraph.h"
 #include "DataStructures.h"
+#include "Parallel.h"
+#include "GraphView.h"
+#include <atomic>
 
 
 namespace graph {
 
-
-/**
- * @brief Performs Breadth-First Search (BFS) on a graph starting from a given vertex.
- * @param g The input graph.
- * @param start The starting vertex for the BFS.
- * @return A BFS tree containing only the edges traversed by the BFS algorithm.
- */
-Graph Algorithms::bfs(const Graph& g, int start) {
-    int numVer = g.getNumVertices();
+namespace {
+
+// Observer used when the caller passes none. Every hook is an empty inline
+// function, so the calls compile away entirely. enabled lets an algorithm skip
+// bookkeeping that only feeds the hooks.
+struct NullObserver {
+    static const bool enabled = false;
+    void edgeRelaxed(int, int, int) {}
+    void vertexSettled(int) {}
+    void treeEdgeAdded(int, int, int) {}
+};
+
+// Forwards the hooks to a caller supplied AlgorithmObserver
+struct ForwardingObserver {
+    static const bool enabled = true;
+    AlgorithmObserver& target;
+
+    void edgeRelaxed(int u, int v, int weight) { target.edgeRelaxed(u, v, weight); }
+    void vertexSettled(int v) { target.vertexSettled(v); }
+    void treeEdgeAdded(int u, int v, int weight) { target.treeEdgeAdded(u, v, weight); }
+};
+
+template <class View, class Obs>
+void bfsSearch(const View& view, int start, TraversalResult& result, Obs& obs) {
+    int numVer = view.numVertices();
     if (start < 0 || start >= numVer) {
         throw std::out_of_range("Vertex " + std::to_string(start) + " is out of bounds");
     }
 
-    Graph tree(numVer);
-    tree.initializeVisitOrder();
+    result.reset(numVer, -1);
+    int* distance = result.distance;
+    int* parent = result.parent;
 
-    Queue q(numVer);
+    // The order array doubles as the BFS queue: vertices are appended when
+    // discovered and dequeued by advancing head, so no separate queue or color
+    // array is needed (distance -1 means white)
+    int* queue = result.order;
+    int head = 0;
+    int tail = 0;
 
-    colors* color = new colors[numVer];
-    int* parent = new int[numVer];
-    int* distance = new int[numVer];
+    queue[tail++] = start;
+    distance[start] = 0; // Distance to start vertex is 0
 
+    while (head < tail) {
+        int u = queue[head++];
+        obs.vertexSettled(u);
 
-    for (int i = 0; i < numVer; ++i) {
-        color[i] = White;
-        distance[i] = -1; // Infinite distance
-        parent[i] = -1;   // No parent
+        for (typename View::Cursor c = view.first(u); view.valid(c); view.advance(c)) {
+            int v = view.target(c);
+            if (distance[v] == -1) {
+                distance[v] = distance[u] + 1;
+                parent[v] = u;
+                result.weight[v] = distance[v];
+                queue[tail++] = v;
+                obs.treeEdgeAdded(u, v, view.weight(c));
+            }
+        }
     }
+    result.orderCount = tail;
+}
 
-    q.enqueue(start);
-    color[start] = Gray;
-    distance[start] = 0; // Distance to start vertex is 0
-    int index = 0;
+// Switch thresholds of the direction-optimizing BFS (Beamer, Asanovic and
+// Patterson): go bottom-up once the frontier's edges exceed 1/ALPHA of the
+// edges of unvisited vertices, go back top-down once the frontier holds fewer
+// than 1/BETA of all vertices
+const int BFS_ALPHA = 14;
+const int BFS_BETA = 24;
+
+// Sum of the degrees of order[begin, end), for views with constant time degree()
+template <class View>
+long long frontierDegrees(const View& view, const int* order, int begin, int end) {
+    long long edges = 0;
+    for (int i = begin; i < end; ++i)
+        edges += view.degree(order[i]);
+    return edges;
+}
 
+// Direction-optimizing BFS. Levels are expanded either top-down (every frontier
+// vertex scans its neighbors, as in bfsSearch) or bottom-up (every unvisited
+// vertex scans its neighbors for one in the frontier bitmap and stops at the
+// first hit). On low-diameter graphs the few big middle levels are done
+// bottom-up, which skips most of their edge examinations.
+// Each level is discovered in full before the next starts, so distances equal
+// bfsSearch's. Parents may differ: bottom-up picks the first frontier neighbor
+// in the vertex's own adjacency order. The order array holds the levels in
+// turn, the vertices found bottom-up sorted by vertex.
+// With constant time degrees (CSRView) a level's frontier edges are summed
+// before it starts. When degree() walks the list (ListView) they are counted
+// while the top-down loop scans them instead, and a level may switch to
+// bottom-up part way through.
+template <class View, class Obs>
+void directionOptimizingBfsSearch(const View& view, int start, TraversalResult& result, Obs& obs) {
+    int numVer = view.numVertices();
+    if (start < 0 || start >= numVer) {
+        throw std::out_of_range("Vertex " + std::to_string(start) + " is out of bounds");
+    }
 
-    while (!q.isEmpty()) {
-        int u = q.dequeue();
-        tree.setVisitOrder(index++, u); // Set visit order for BFS
+    result.reset(numVer, -1);
+    int* distance = result.distance;
+    int* parent = result.parent;
+    int* order = result.order;
 
-        Node* curr = g.getAdjList(u);
+    // Bitmap of the current frontier, only filled for bottom-up levels
+    int words = (numVer + 63) / 64;
+    unsigned long long* frontier = new unsigned long long[words]();
 
-		// Check if vertex index is valid
-		if(u < 0 || u >= numVer) {
-			throw std::out_of_range("Invalid vertex index: " + std::to_string(u));
-		}
-        while (curr != nullptr) {
-            int v = curr->vertex;
-            if (color[v] == White) {
-                color[v] = Gray;
-                distance[v] = distance[u] + 1;
-                parent[v] = u; 
-                q.enqueue(v);
+    order[0] = start;
+    distance[start] = 0;
+    int levelBegin = 0;
+    int levelEnd = 1;
+    int level = 0;
+    long long unexploredEdges = view.numEntries();
+    bool topDown = true;
+
+    while (levelBegin < levelEnd) {
+        int frontierSize = levelEnd - levelBegin;
+        if (!topDown && frontierSize < numVer / BFS_BETA)
+            topDown = true;
+
+        long long threshold = unexploredEdges / BFS_ALPHA;
+        if (topDown && View::constantDegree && frontierDegrees(view, order, levelBegin, levelEnd) > threshold)
+            topDown = false;
+
+        int tail = levelEnd;
+        int bottomUpBegin = levelBegin; // First frontier vertex left to the bottom-up pass
+        if (topDown) {
+            // Frontier edges are counted as they are scanned, once they pass the
+            // threshold the rest of the level is handed to the bottom-up pass
+            long long frontierEdges = 0;
+            while (bottomUpBegin < levelEnd && frontierEdges <= threshold) {
+                int u = order[bottomUpBegin++];
+                obs.vertexSettled(u);
+                int scanned = 0;
+                for (typename View::Cursor c = view.first(u); view.valid(c); view.advance(c)) {
+                    ++scanned;
+                    int v = view.target(c);
+                    if (distance[v] == -1) {
+                        distance[v] = level + 1;
+                        parent[v] = u;
+                        result.weight[v] = distance[v];
+                        order[tail++] = v;
+                        obs.treeEdgeAdded(u, v, view.weight(c));
+                    }
+                }
+                frontierEdges += scanned;
             }
-            curr = curr->next;
+            unexploredEdges -= frontierEdges;
+            if (frontierEdges > threshold)
+                topDown = false;
         }
-        color[u] = Black;
-    }
-
-    for (int i = 0; i < numVer; ++i) {
-        if (parent[i] != -1) {
-            tree.addEdge(parent[i], i, distance[i]); 
+        if (bottomUpBegin < levelEnd) {
+            // Vertices next to the frontier part already expanded are discovered,
+            // so the unvisited ones only need to look for the rest of it
+            for (int i = bottomUpBegin; i < levelEnd; ++i) {
+                int u = order[i];
+                frontier[u >> 6] |= 1ULL << (u & 63);
+                obs.vertexSettled(u);
+            }
+            for (int v = 0; v < numVer; ++v) {
+                if (distance[v] != -1)
+                    continue;
+                for (typename View::Cursor c = view.first(v); view.valid(c); view.advance(c)) {
+                    int u = view.target(c);
+                    if (frontier[u >> 6] & (1ULL << (u & 63))) {
+                        distance[v] = level + 1;
+                        parent[v] = u;
+                        result.weight[v] = distance[v];
+                        order[tail++] = v;
+                        obs.treeEdgeAdded(u, v, view.weight(c));
+                        break;
+                    }
+                }
+            }
+            for (int i = bottomUpBegin; i < levelEnd; ++i) {
+                frontier[order[i] >> 6] = 0;
+            }
+            // The lists of this part of the frontier were never read, without
+            // constant time degrees they are estimated by the average degree
+            if (View::constantDegree)
+                unexploredEdges -= frontierDegrees(view, order, bottomUpBegin, levelEnd);
+            else
+                unexploredEdges -= (levelEnd - bottomUpBegin) * (view.numEntries() / numVer);
+            if (unexploredEdges < 0)
+                unexploredEdges = 0;
         }
+
+        levelBegin = levelEnd;
+        levelEnd = tail;
+        ++level;
     }
+    result.orderCount = levelEnd;
+    delete[] frontier;
+}
 
-    delete[] color;
-    delete[] distance;
-    delete[] parent;
+// One suspended vertex of the iterative DFS: the vertex and
+// the cursor to the next neighbor still to be examined
+template <class View>
+struct DfsFrame {
+    int u;
+    typename View::Cursor c;
+};
+
+// DFS output that builds a tree Graph, used by dfs_visit
+struct DfsTreeSink {
+    Graph& tree;
+    int& index;
+
+    void visit(int v) { tree.setVisitOrder(index++, v); }
+    void treeEdge(int u, int v, int weight) { tree.addEdge(u, v, weight); }
+};
+
+// DFS output that fills a TraversalResult and reports to an observer
+template <class Obs>
+struct DfsResultSink {
+    TraversalResult& result;
+    Obs& obs;
+
+    void visit(int v) {
+        if (result.parent[v] == -1)
+            result.distance[v] = 0; // Root of a new DFS tree
+        result.order[result.orderCount++] = v;
+        obs.vertexSettled(v);
+    }
+    void treeEdge(int u, int v, int weight) {
+        result.parent[v] = u;
+        result.weight[v] = weight;
+        result.distance[v] = result.distance[u] + 1;
+        obs.treeEdgeAdded(u, v, weight);
+    }
+};
+
+// Iterative DFS from u using an explicit stack of adjacency cursors.
+// Visits vertices and adds tree edges in exactly the order of the recursive
+// version, but its depth is bounded by the stack array (numVertices frames)
+// instead of the call stack.
+template <class View, class Sink>
+void dfsVisit(const View& view, int u, colors* color, DfsFrame<View>* stack, Sink& sink) {
+    int top = 0;
+    color[u] = Gray;
+    sink.visit(u);
+    stack[top++] = DfsFrame<View>{u, view.first(u)};
+
+    while (top > 0) {
+        DfsFrame<View>& frame = stack[top - 1];
+        if (!view.valid(frame.c)) {
+            // All neighbors examined, return to the parent
+            color[frame.u] = Black;
+            --top;
+            continue;
+        }
 
-    std::cout << "BFS Tree built successfully" << std::endl;
+        int v = view.target(frame.c);
+        int weight = view.weight(frame.c);
+        view.advance(frame.c);
 
-    return tree;
+        if (color[v] == White) {
+            sink.treeEdge(frame.u, v, weight); // Tree edge
+            color[v] = Gray;
+            sink.visit(v);
+            stack[top++] = DfsFrame<View>{v, view.first(v)};
+        }
+    }
 }
 
+template <class View, class Obs>
+void dfsSearch(const View& view, int start, TraversalResult& result, Obs& obs) {
+    int numVer = view.numVertices();
+    if (start < 0 || start >= numVer) {
+        throw std::out_of_range("Vertex " + std::to_string(start) + " is out of bounds");
+    }
 
-/**
- * @brief Performs Depth-First Search (DFS) on a graph starting from a given vertex.
- * @param g The input graph.
- * @param start The starting vertex for the DFS.
- * @return A DFS tree or forest containing only the tree edges found by the DFS algorithm.
- */
-Graph Algorithms::dfs(const Graph& g, int start) {
-    int numVer = g.getNumVertices();
-    Graph tree(numVer);
-    tree.initializeVisitOrder();
+    result.reset(numVer, -1);
+    DfsResultSink<Obs> sink{result, obs};
 
     colors* color = new colors[numVer];
-    int index = 0;
+    DfsFrame<View>* stack = new DfsFrame<View>[numVer];
 
     for (int i = 0; i < numVer; ++i) {
         color[i] = White;
     }
 
-    if (start < 0 || start >= numVer) {
-        throw std::out_of_range("Vertex " + std::to_string(start) + " is out of bounds");
-    }
-
     // Start DFS from the given vertex
-    dfs_visit(g, tree, start, color, index);
+    dfsVisit(view, start, color, stack, sink);
 
     // If the graph is disconnected, we need to visit all vertices
     // that haven't been visited yet to ensure the DFS tree covers the entire graph
     for (int u = 0; u < numVer; ++u) {
         if (color[u] == White) {
-            dfs_visit(g, tree, u, color, index);
+            dfsVisit(view, u, color, stack, sink);
         }
     }
 
     delete[] color;
-
-    std::cout << "DFS Tree/Forest built successfully" << std::endl;
-    return tree;
+    delete[] stack;
 }
-/**
- * @brief A recursive helper function for DFS traversal.
- * @param g The input graph.
- * @param tree The tree being built.
- * @param u The current vertex being visited.
- * @param color Array indicating the visit status of each vertex.
- * @param index The current index for visit order tracking.
- */
-void Algorithms::dfs_visit(const Graph& g, Graph& tree, int u, colors* color, int& index) {
-    // Check if vertex index is valid
-    if (u < 0 || u >= g.getNumVertices()) {
-        throw std::out_of_range("Invalid vertex index: " + std::to_string(u));
-    }
-    color[u] = Gray;
-    tree.setVisitOrder(index++, u); // Set visit order for DFS    
-    
-    // Iterate through the adjacency list of vertex u
-    // and recursively visit all unvisited neighbors
-    Node* curr = g.getAdjList(u);
-    while (curr != nullptr) {
-        int v = curr->vertex;
-        if (color[v] == White) {
-            tree.addEdge(u, v, curr->weight); // Tree edge 
-            dfs_visit(g, tree, v, color, index);
-        }
-        curr = curr->next;
-    }
 
-    color[u] = Black;
+// Clears the target flags set by dijkstraSearch
+inline void clearTargets(const DijkstraLimits& limits, bool* isTarget) {
+    for (int i = 0; i < limits.numTargets; ++i) {
+        isTarget[limits.targets[i]] = false;
+    }
 }
-/**
- * @brief Finds the shortest paths from a source vertex to all other vertices using Dijkstra's algorithm.
- * @param g The input graph.
- * @param start The source vertex.
- * @return A shortest path tree representing the minimum distances from the source to each reachable vertex.
- * @throws std::invalid_argument If the graph contains negative weight edges.
- */
-Graph Algorithms::dijkstra(const Graph& g, int start) {
-    int numVer = g.getNumVertices();
+
+// Dijkstra that stops early under limits: once every target is settled, or
+// once the closest unsettled vertex is farther than limits.maxDistance.
+// Vertices still in the queue at that point are cleared back to unreached, so
+// result holds exactly the settled vertices.
+template <class View, class Obs>
+void dijkstraSearch(const View& view, int start, const DijkstraLimits& limits, TraversalResult& result, Obs& obs) {
+    int numVer = view.numVertices();
 
     if (start < 0 || start >= numVer) {
         throw std::out_of_range("Start vertex " + std::to_string(start) + " is out of bounds");
     }
+    for (int i = 0; i < limits.numTargets; ++i) {
+        if (limits.targets[i] < 0 || limits.targets[i] >= numVer) {
+            throw std::out_of_range("Target vertex " + std::to_string(limits.targets[i]) + " is out of bounds");
+        }
+    }
 
-    int* distance = new int[numVer];
-    int* prev = new int[numVer];
-
-    for (int i = 0; i < numVer; ++i) {
-        distance[i] = INT_MAX;
-        prev[i] = -1;
+    // After a previous dijkstra only its settled vertices need clearing, and the
+    // queue and target flags come back empty from the result's scratch
+    result.resetSparse(numVer, INT_MAX);
+    int* distance = result.distance;
+    SearchScratch& scratch = result.scratch();
+    scratch.prepare(numVer, 0);
+
+    // Targets not settled yet, none without targets
+    bool* isTarget = scratch.flag;
+    int remaining = 0;
+    for (int i = 0; i < limits.numTargets; ++i) {
+        if (!isTarget[limits.targets[i]]) {
+            isTarget[limits.targets[i]] = true;
+            ++remaining;
+        }
     }
 
-    PriorityQueue pq(numVer);
-    bool* visited = new bool[numVer]();
+    // With the indexed PriorityQueue every vertex is extracted exactly once, and a
+    // settled vertex can never be relaxed again (its distance is already minimal),
+    // so no separate visited array is needed
+    PriorityQueue& pq = *scratch.queue[0];
 
     distance[start] = 0;
     pq.insert(start, 0);
 
-    int index = 0;
-
-    while (!pq.isEmpty()) {
+    while (!pq.isEmpty() && pq.minPriority() <= limits.maxDistance) {
         int u = pq.extractMin();
+        result.order[result.orderCount++] = u;
+        obs.vertexSettled(u);
+        if (result.parent[u] != -1)
+            obs.treeEdgeAdded(result.parent[u], u, result.weight[u]);
+        if (isTarget[u] && --remaining == 0)
+            break;
 
-        if (visited[u]) continue;
-        visited[u] = true;
-
-        Node* curr = g.getAdjList(u);
-        while (curr != nullptr) {
-            int v = curr->vertex;
-            int weight = curr->weight;
+        for (typename View::Cursor c = view.first(u); view.valid(c); view.advance(c)) {
+            int v = view.target(c);
+            int weight = view.weight(c);
 
             if (weight < 0) {
-                delete[] distance;
-                delete[] prev;
-                delete[] visited;
+                clearTargets(limits, isTarget);
+                scratch.finish();
                 throw std::invalid_argument("Negative edge weight detected. Dijkstra cannot handle negative weights.");
             }
 
-            if (!visited[v] && distance[u] + weight < distance[v]) {
+            if (distance[u] + weight < distance[v]) {
                 distance[v] = distance[u] + weight;
-                prev[v] = u;
+                result.parent[v] = u;
+                result.weight[v] = weight;
+                obs.edgeRelaxed(u, v, weight);
 
                 if (pq.contains(v)) {
                     pq.decreasePriority(v, distance[v]);
@@ -206,88 +386,56 @@ Graph Algorithms::dijkstra(const Graph& g, int start) {
                     pq.insert(v, distance[v]);
                 }
             }
-
-            curr = curr->next;
         }
     }
 
-    // Build the shortest path tree
-    Graph tree(numVer);
-    tree.initializeVisitOrder();
-
-    for (int v = 0; v < numVer; ++v) {
-        if (prev[v] != -1) {
-            // Find the original weight from the graph
-            int edgeWeight = 0;
-            Node* curr = g.getAdjList(prev[v]);
-            while (curr != nullptr) {
-                if (curr->vertex == v) {
-                    edgeWeight = curr->weight;
-                    break;
-                }
-                curr = curr->next;
-            }
-
-            tree.addEdge(prev[v], v, edgeWeight);
-
-            std::cout << "Added edge: " << prev[v] << " - " << v << " weight: " << edgeWeight << std::endl;
-
-
-            tree.setVisitOrder(index++, v);
-        }
+    // Forget the tentative labels of vertices that were never settled,
+    // so only the vertices in order differ from a cleared result
+    while (!pq.isEmpty()) {
+        int v = pq.extractMin();
+        distance[v] = INT_MAX;
+        result.parent[v] = -1;
+        result.weight[v] = 0;
     }
-
-    delete[] distance;
-    delete[] prev;
-    delete[] visited;
-
-    std::cout << "Dijkstra Tree built successfully" << std::endl;
-
-    return tree;
+    clearTargets(limits, isTarget);
+    scratch.finish();
+    result.markSparse(INT_MAX);
 }
 
+template <class View, class Obs>
+void primSearch(const View& view, TraversalResult& result, Obs& obs) {
+    int n = view.numVertices();
 
-/**
- * @brief Finds a Minimum Spanning Tree (MST) using Prim's algorithm.
- * @param g The input graph.
- * @return The MST of the graph.
- */
-Graph Algorithms::prim(const Graph& g) {
-    int n = g.getNumVertices();
-    Graph tree(n);
-    tree.initializeVisitOrder();
+    result.reset(n, INT_MAX);
+    int* key = result.distance;
+    int* parent = result.parent;
 
     PriorityQueue pq(n);
     bool* inTree = new bool[n]();
-    int* key = new int[n];
-    int* parent = new int[n];
-
-    for (int i = 0; i < n; ++i) {
-        key[i] = INT_MAX;
-        parent[i] = -1;
-    }
 
     key[0] = 0;
     pq.insert(0, 0);
 
-    int index = 0;
-
     while (!pq.isEmpty()) {
         int u = pq.extractMin();
 
         if (inTree[u]) continue;
         inTree[u] = true;
 
-        tree.setVisitOrder(index++, u);
+        result.order[result.orderCount++] = u;
+        obs.vertexSettled(u);
+        if (parent[u] != -1)
+            obs.treeEdgeAdded(parent[u], u, result.weight[u]);
 
-        Node* curr = g.getAdjList(u);
-        while (curr != nullptr) {
-            int v = curr->vertex;
-            int weight = curr->weight;
+        for (typename View::Cursor c = view.first(u); view.valid(c); view.advance(c)) {
+            int v = view.target(c);
+            int weight = view.weight(c);
 
             if (!inTree[v] && weight < key[v]) {
                 key[v] = weight;
                 parent[v] = u;
+                result.weight[v] = weight;
+                obs.edgeRelaxed(u, v, weight);
 
                 if (pq.contains(v)) {
                     pq.decreasePriority(v, key[v]);
@@ -295,89 +443,2341 @@ Graph Algorithms::prim(const Graph& g) {
                     pq.insert(v, key[v]);
                 }
             }
-
-            curr = curr->next;
-        }
-    }
-
-    for (int v = 1; v < n; ++v) {
-        if (parent[v] != -1) {
-            tree.addEdge(parent[v], v, key[v]);
         }
     }
 
     delete[] inTree;
-    delete[] key;
-    delete[] parent;
-
-    return tree;
 }
-/**
- * @brief Finds a Minimum Spanning Tree (MST) using Kruskal's algorithm.
- * @param g The input graph.
- * @return The MST of the graph.
- */
-Graph Algorithms::kruskal(const Graph& g) {
-    int n = g.getNumVertices();
-    Graph tree(n);
-    tree.initializeVisitOrder();
 
-    UnionFind uf(n);
+// Root every tree of an MST forest given as an edge list.
+// order already holds the tree vertices, each component is rooted at its
+// first vertex in order and parents/depths are assigned by a BFS over the tree edges.
+void rootForest(const Edge* tree, int edgeCount, TraversalResult& result) {
+    int n = result.numVertices;
+
+    // Tree adjacency in CSR form, entry i of a row holds the index of the edge
+    int* offsets = new int[n + 1]();
+    for (int i = 0; i < edgeCount; ++i) {
+        ++offsets[tree[i].from + 1];
+        ++offsets[tree[i].to + 1];
+    }
+    for (int v = 0; v < n; ++v) {
+        offsets[v + 1] += offsets[v];
+    }
+    int* fill = new int[n];
+    for (int v = 0; v < n; ++v) {
+        fill[v] = offsets[v];
+    }
+    int* incident = new int[2 * edgeCount];
+    for (int i = 0; i < edgeCount; ++i) {
+        incident[fill[tree[i].from]++] = i;
+        incident[fill[tree[i].to]++] = i;
+    }
 
-    struct Edge {
-        int u, v, w;
-    };
+    // fill is reused as the BFS queue
+    int* queue = fill;
+    for (int i = 0; i < result.orderCount; ++i) {
+        int root = result.order[i];
+        if (result.distance[root] != -1)
+            continue;
+        result.distance[root] = 0;
+        int head = 0;
+        int tail = 0;
+        queue[tail++] = root;
+        while (head < tail) {
+            int u = queue[head++];
+            for (int k = offsets[u]; k < offsets[u + 1]; ++k) {
+                const Edge& e = tree[incident[k]];
+                int v = e.from == u ? e.to : e.from;
+                if (result.distance[v] == -1) {
+                    result.distance[v] = result.distance[u] + 1;
+                    result.parent[v] = u;
+                    result.weight[v] = e.weight;
+                    queue[tail++] = v;
+                }
+            }
+        }
+    }
 
-    Edge* edges = new Edge[n * n];
-    int edgeCount = 0;
+    delete[] offsets;
+    delete[] fill;
+    delete[] incident;
+}
 
-    PriorityQueue pq(n * n);
+// Collect every undirected edge once (from < to) into an array of exactly
+// the right size, in adjacency order. edgeCount receives the number of edges.
+template <class View>
+Edge* extractEdges(const View& view, int& edgeCount) {
+    int n = view.numVertices();
+    edgeCount = 0;
+    for (int u = 0; u < n; ++u) {
+        for (typename View::Cursor c = view.first(u); view.valid(c); view.advance(c)) {
+            if (u < view.target(c))
+                ++edgeCount;
+        }
+    }
 
+    Edge* edges = new Edge[edgeCount > 0 ? edgeCount : 1];
+    int pos = 0;
     for (int u = 0; u < n; ++u) {
-        Node* curr = g.getAdjList(u);
-        while (curr != nullptr) {
-            int v = curr->vertex;
-            if (u < v) {
-                edges[edgeCount] = {u, v, curr->weight};
-                pq.insert(edgeCount, curr->weight);
-                edgeCount++;
+        for (typename View::Cursor c = view.first(u); view.valid(c); view.advance(c)) {
+            int v = view.target(c);
+            if (u < v)
+                edges[pos++] = Edge{u, v, view.weight(c)};
+        }
+    }
+    return edges;
+}
+
+// Stable bottom-up merge sort of edges by weight, O(E log E)
+void mergeSortByWeight(Edge* edges, int count) {
+    Edge* buffer = new Edge[count > 0 ? count : 1];
+    Edge* from = edges;
+    Edge* to = buffer;
+    for (int width = 1; width < count; width *= 2) {
+        for (int lo = 0; lo < count; lo += 2 * width) {
+            int mid = lo + width < count ? lo + width : count;
+            int hi = lo + 2 * width < count ? lo + 2 * width : count;
+            int i = lo;
+            int j = mid;
+            int k = lo;
+            while (i < mid && j < hi) {
+                // Take from the left run on ties to keep the sort stable
+                if (from[j].weight < from[i].weight)
+                    to[k++] = from[j++];
+                else
+                    to[k++] = from[i++];
             }
-            curr = curr->next;
+            while (i < mid)
+                to[k++] = from[i++];
+            while (j < hi)
+                to[k++] = from[j++];
+        }
+        Edge* temp = from;
+        from = to;
+        to = temp;
+    }
+    if (from != edges) {
+        for (int i = 0; i < count; ++i)
+            edges[i] = from[i];
+    }
+    delete[] buffer;
+}
+
+// Stable LSD radix sort of edges by weight, 8 bits per pass, O(E) per pass.
+// Weights are mapped to unsigned keys by flipping the sign bit so negative
+// weights sort first. A pass is skipped when every key has the same byte
+// there, so small weight ranges need only one or two passes.
+void radixSortByWeight(Edge* edges, int count) {
+    if (count < 2)
+        return;
+
+    Edge* buffer = new Edge[count];
+    Edge* from = edges;
+    Edge* to = buffer;
+    int* bucket = new int[257];
+
+    for (int shift = 0; shift < 32; shift += 8) {
+        for (int b = 0; b <= 256; ++b)
+            bucket[b] = 0;
+        for (int i = 0; i < count; ++i) {
+            unsigned int key = static_cast<unsigned int>(from[i].weight) ^ 0x80000000u;
+            ++bucket[((key >> shift) & 0xFF) + 1];
+        }
+        // Every key falls in one bucket, the pass would not change the order
+        bool trivial = false;
+        for (int b = 1; b <= 256; ++b) {
+            if (bucket[b] == count)
+                trivial = true;
+        }
+        if (trivial)
+            continue;
+
+        for (int b = 0; b < 256; ++b)
+            bucket[b + 1] += bucket[b];
+        for (int i = 0; i < count; ++i) {
+            unsigned int key = static_cast<unsigned int>(from[i].weight) ^ 0x80000000u;
+            to[bucket[(key >> shift) & 0xFF]++] = from[i];
         }
+        Edge* temp = from;
+        from = to;
+        to = temp;
     }
 
-    int index = 0;
-    int edgesAdded = 0;
+    if (from != edges) {
+        for (int i = 0; i < count; ++i)
+            edges[i] = from[i];
+    }
+    delete[] buffer;
+    delete[] bucket;
+}
+
+// Incremental MST forest shared by the Kruskal variants: edges are offered in
+// non-decreasing weight order and accepted when they join two components.
+// finish() roots the forest.
+template <class Obs>
+class KruskalForest {
+private:
+    TraversalResult& result;
+    Obs& obs;
+    UnionFind uf;
+    bool* visited;
+    Edge* tree;
+    int edgesAdded;
+
+public:
+    KruskalForest(TraversalResult& res, Obs& observer)
+        : result(res), obs(observer), uf(res.numVertices), visited(new bool[res.numVertices]()),
+          tree(new Edge[res.numVertices]), edgesAdded(0) {}
+
+    ~KruskalForest() {
+        delete[] visited;
+        delete[] tree;
+    }
 
-    bool* visited = new bool[n](); 
+    KruskalForest(const KruskalForest&) = delete;
+    KruskalForest& operator=(const KruskalForest&) = delete;
 
-    while (!pq.isEmpty() && edgesAdded < n - 1) {
-        int idx = pq.extractMin();
-        Edge edge = edges[idx];
-        int u = edge.u;
-        int v = edge.v;
+    // True once the forest spans the graph (n - 1 edges), no edge can be accepted after that
+    bool complete() const { return edgesAdded >= result.numVertices - 1; }
 
-        if (uf.find(u) != uf.find(v)) {
-            tree.addEdge(u, v, edge.w);
-            uf.unite(u, v);
+    bool connected(int u, int v) { return uf.find(u) == uf.find(v); }
 
-            if (!visited[u]) { 
-                tree.setVisitOrder(index++, u);
+    void offer(const Edge& edge) {
+        int u = edge.from;
+        int v = edge.to;
+
+        if (uf.unite(u, v)) {
+            tree[edgesAdded] = edge;
+
+            if (!visited[u]) {
+                result.order[result.orderCount++] = u;
                 visited[u] = true;
+                obs.vertexSettled(u);
             }
-            if (!visited[v]) { 
-                tree.setVisitOrder(index++, v);
+            if (!visited[v]) {
+                result.order[result.orderCount++] = v;
                 visited[v] = true;
+                obs.vertexSettled(v);
             }
+            obs.treeEdgeAdded(u, v, edge.weight);
 
             edgesAdded++;
         }
     }
 
+    void finish() { rootForest(tree, edgesAdded, result); }
+};
+
+// Kruskal's main loop over edges already sorted by weight: accept every edge
+// joining two components until the forest has n - 1 edges, then root the forest
+template <class Obs>
+void kruskalScan(const Edge* sorted, int edgeCount, TraversalResult& result, Obs& obs) {
+    KruskalForest<Obs> forest(result, obs);
+    for (int i = 0; i < edgeCount && !forest.complete(); ++i) {
+        forest.offer(sorted[i]);
+    }
+    forest.finish();
+}
+
+// Below this many edges filter-Kruskal just sorts and scans
+static const int FILTER_KRUSKAL_THRESHOLD = 256;
+
+// Filter-Kruskal on edges[0..count):
+// partition around a pivot weight into light (<), equal (==) and heavy (>) edges,
+// solve the light part recursively, offer the equal edges, then drop every heavy
+// edge whose endpoints are already connected before recursing on the rest.
+// seed drives the pseudo-random pivot choice.
+template <class Obs>
+void filterKruskalRange(Edge* edges, int count, KruskalForest<Obs>& forest, unsigned int& seed) {
+    if (count == 0 || forest.complete())
+        return;
+
+    if (count <= FILTER_KRUSKAL_THRESHOLD) {
+        mergeSortByWeight(edges, count);
+        for (int i = 0; i < count && !forest.complete(); ++i) {
+            forest.offer(edges[i]);
+        }
+        return;
+    }
+
+    seed = seed * 1103515245u + 12345u;
+    int pivot = edges[(seed >> 8) % static_cast<unsigned int>(count)].weight;
+
+    // Three-way partition: [0, lt) light, [lt, gt) equal, [gt, count) heavy
+    int lt = 0;
+    int i = 0;
+    int gt = count;
+    while (i < gt) {
+        if (edges[i].weight < pivot) {
+            Edge temp = edges[lt];
+            edges[lt++] = edges[i];
+            edges[i++] = temp;
+        } else if (edges[i].weight > pivot) {
+            Edge temp = edges[--gt];
+            edges[gt] = edges[i];
+            edges[i] = temp;
+        } else {
+            ++i;
+        }
+    }
+
+    filterKruskalRange(edges, lt, forest, seed);
+
+    for (int k = lt; k < gt && !forest.complete(); ++k) {
+        forest.offer(edges[k]);
+    }
+    if (forest.complete())
+        return;
+
+    // Filter: keep only heavy edges that still join two components
+    Edge* heavy = edges + gt;
+    int kept = 0;
+    for (int k = 0; k < count - gt; ++k) {
+        if (!forest.connected(heavy[k].from, heavy[k].to))
+            heavy[kept++] = heavy[k];
+    }
+    filterKruskalRange(heavy, kept, forest, seed);
+}
+
+template <class View, class Obs>
+void filterKruskalSearch(const View& view, TraversalResult& result, Obs& obs) {
+    result.reset(view.numVertices(), -1);
+
+    int edgeCount = 0;
+    Edge* edges = extractEdges(view, edgeCount);
+    KruskalForest<Obs> forest(result, obs);
+    unsigned int seed = 0x9e3779b9u;
+    filterKruskalRange(edges, edgeCount, forest, seed);
+    forest.finish();
+
+    delete[] edges;
+}
+
+// Kruskal with buffers sized by the real edge count, sorting the edges
+// with an O(E log E) merge sort or an O(E) radix sort
+template <class View, class Obs>
+void kruskalSearch(const View& view, KruskalSort mode, TraversalResult& result, Obs& obs) {
+    result.reset(view.numVertices(), -1);
+
+    int edgeCount = 0;
+    Edge* edges = extractEdges(view, edgeCount);
+    Algorithms::sortEdgesByWeight(edges, edgeCount, mode);
+    kruskalScan(edges, edgeCount, result, obs);
+
+    delete[] edges;
+}
+
+// Boruvka selection key of edge i: the weight (sign flipped so that unsigned
+// order is weight order) in the high word and the edge index in the low word.
+// Ties are broken by index, which gives all edges a strict total order so the
+// lightest outgoing edges of all components never form a cycle.
+inline unsigned long long boruvkaKey(const Edge& edge, int index) {
+    unsigned long long w = static_cast<unsigned int>(edge.weight) ^ 0x80000000u;
+    return (w << 32) | static_cast<unsigned int>(index);
+}
+
+static const unsigned long long NO_EDGE = ~0ULL;
+
+// Lower target to key if key is smaller, lock-free
+inline void atomicMin(std::atomic<unsigned long long>& target, unsigned long long key) {
+    unsigned long long current = target.load(std::memory_order_relaxed);
+    while (key < current && !target.compare_exchange_weak(current, key, std::memory_order_relaxed)) {
+    }
+}
+
+// Parallel Boruvka on a shared ConcurrentUnionFind. Each round:
+// 1. In parallel, comp[v] = component of v.
+// 2. In parallel over the remaining edges, every component records its lightest
+//    outgoing edge with an atomic min on best[component].
+// 3. In parallel over the components, the selected edges are united. An edge
+//    picked by both of its components is united (and kept) only once.
+// 4. In parallel, edges that now lie inside one component are dropped
+//    (each thread compacts its own chunk, then the chunks are concatenated).
+// At least half of the components merge per round, so there are O(log V) rounds.
+// The accepted edges are then reported in component order on one thread.
+template <class View, class Obs>
+void boruvkaSearch(const View& view, int numThreads, TraversalResult& result, Obs& obs) {
+    int n = view.numVertices();
+    result.reset(n, -1);
+    numThreads = resolveThreadCount(numThreads);
+
+    int edgeCount = 0;
+    Edge* edges = extractEdges(view, edgeCount);
+    Edge* spare = new Edge[edgeCount > 0 ? edgeCount : 1];
+    int* comp = new int[n];
+    std::atomic<unsigned long long>* best = new std::atomic<unsigned long long>[n];
+    bool* selected = new bool[n]; // Component v united its best edge this round
+    int* chunkKept = new int[numThreads + 1];
+    Edge* tree = new Edge[n];
+    int treeCount = 0;
+    bool* visited = new bool[n]();
+    for (int v = 0; v < n; ++v) {
+        best[v].store(NO_EDGE, std::memory_order_relaxed);
+    }
+
+    ConcurrentUnionFind uf(n);
+
+    while (edgeCount > 0) {
+        parallelChunks(n, numThreads, [&](int, int begin, int end) {
+            for (int v = begin; v < end; ++v) {
+                comp[v] = uf.find(v);
+                selected[v] = false;
+            }
+        });
+
+        parallelChunks(edgeCount, numThreads, [&](int, int begin, int end) {
+            for (int i = begin; i < end; ++i) {
+                int cu = comp[edges[i].from];
+                int cv = comp[edges[i].to];
+                if (cu != cv) {
+                    unsigned long long key = boruvkaKey(edges[i], i);
+                    atomicMin(best[cu], key);
+                    atomicMin(best[cv], key);
+                }
+            }
+        });
+
+        parallelChunks(n, numThreads, [&](int, int begin, int end) {
+            for (int c = begin; c < end; ++c) {
+                if (comp[c] != c)
+                    continue;
+                unsigned long long key = best[c].load(std::memory_order_relaxed);
+                if (key == NO_EDGE)
+                    continue;
+                const Edge& edge = edges[static_cast<unsigned int>(key & 0xFFFFFFFFu)];
+                selected[c] = uf.unite(edge.from, edge.to);
+            }
+        });
+
+        // Collect this round's tree edges, in component order
+        for (int c = 0; c < n; ++c) {
+            if (comp[c] == c) {
+                unsigned long long key = best[c].load(std::memory_order_relaxed);
+                if (selected[c])
+                    tree[treeCount++] = edges[static_cast<unsigned int>(key & 0xFFFFFFFFu)];
+                best[c].store(NO_EDGE, std::memory_order_relaxed);
+            }
+        }
+
+        // Drop edges inside one component: count per chunk, then copy to the chunk's offset
+        for (int t = 0; t <= numThreads; ++t) {
+            chunkKept[t] = 0;
+        }
+        parallelChunks(edgeCount, numThreads, [&](int t, int begin, int end) {
+            int kept = 0;
+            for (int i = begin; i < end; ++i) {
+                if (!uf.sameSet(edges[i].from, edges[i].to))
+                    ++kept;
+            }
+            chunkKept[t + 1] = kept;
+        });
+        for (int t = 0; t < numThreads; ++t) {
+            chunkKept[t + 1] += chunkKept[t];
+        }
+        parallelChunks(edgeCount, numThreads, [&](int t, int begin, int end) {
+            int pos = chunkKept[t];
+            for (int i = begin; i < end; ++i) {
+                if (!uf.sameSet(edges[i].from, edges[i].to))
+                    spare[pos++] = edges[i];
+            }
+        });
+        edgeCount = chunkKept[numThreads];
+        Edge* temp = edges;
+        edges = spare;
+        spare = temp;
+    }
+
+    for (int i = 0; i < treeCount; ++i) {
+        int u = tree[i].from;
+        int v = tree[i].to;
+        if (!visited[u]) {
+            result.order[result.orderCount++] = u;
+            visited[u] = true;
+            obs.vertexSettled(u);
+        }
+        if (!visited[v]) {
+            result.order[result.orderCount++] = v;
+            visited[v] = true;
+            obs.vertexSettled(v);
+        }
+        obs.treeEdgeAdded(u, v, tree[i].weight);
+    }
+    rootForest(tree, treeCount, result);
+
     delete[] edges;
+    delete[] spare;
+    delete[] comp;
+    delete[] best;
+    delete[] selected;
+    delete[] chunkKept;
+    delete[] tree;
     delete[] visited;
+}
 
-    return tree;
+// Multi-source BFS, 64 sources per batch. Bit i of a vertex's masks stands for
+// the i-th source of the batch: seen[v] has the sources that reached v,
+// frontier[v] those that reached it on the current level. One level pushes
+// each frontier mask to all neighbors with a single OR per adjacency entry, so
+// the batch shares one pass over the adjacency per level instead of one per
+// source. The distances of each new bit are then written out.
+// Like bfsSearch's queue, a level only visits the vertices of its frontier list
+// and the neighbors they touched, so a batch is O(V + E) however many levels
+// the graph has. Levels with at least V / MULTI_SOURCE_SWEEP_DIVISOR frontier
+// vertices sweep all V in index order instead: sequential reads are faster there,
+// and a sweep costs at most MULTI_SOURCE_SWEEP_DIVISOR times the frontier, so the
+// linear bound still holds.
+static const int MULTI_SOURCE_SWEEP_DIVISOR = 32;
+
+template <class View>
+void multiSourceBfsSearch(const View& view, const int* sources, int numSources, int* distances) {
+    int n = view.numVertices();
+    if (numSources < 0) {
+        throw std::invalid_argument("Number of sources must be non-negative");
+    }
+    for (int i = 0; i < numSources; ++i) {
+        if (sources[i] < 0 || sources[i] >= n) {
+            throw std::out_of_range("Vertex " + std::to_string(sources[i]) + " is out of bounds");
+        }
+    }
+
+    unsigned long long* seen = new unsigned long long[n];
+    unsigned long long* frontier = new unsigned long long[n];
+    unsigned long long* next = new unsigned long long[n];
+    int* frontierList = new int[n]; // Vertices with a non-zero frontier mask
+    int* nextList = new int[n];
+    int* touched = new int[n];      // Vertices whose next mask became non-zero this level
+
+    for (int batchStart = 0; batchStart < numSources; batchStart += 64) {
+        int batchSize = numSources - batchStart < 64 ? numSources - batchStart : 64;
+        int* batchDistances = distances + static_cast<long long>(batchStart) * n;
+        for (long long i = 0; i < static_cast<long long>(batchSize) * n; ++i) {
+            batchDistances[i] = -1;
+        }
+        for (int v = 0; v < n; ++v) {
+            seen[v] = 0;
+            frontier[v] = 0;
+            next[v] = 0;
+        }
+        int frontierSize = 0;
+        for (int i = 0; i < batchSize; ++i) {
+            int s = sources[batchStart + i];
+            if (frontier[s] == 0)
+                frontierList[frontierSize++] = s;
+            seen[s] |= 1ULL << i;
+            frontier[s] |= 1ULL << i;
+            batchDistances[static_cast<long long>(i) * n + s] = 0;
+        }
+
+        for (int level = 1; frontierSize > 0; ++level) {
+            // A wide level sweeps all vertices in index order instead, which reads
+            // the masks sequentially and is faster once most vertices are touched
+            bool sweep = frontierSize >= n / MULTI_SOURCE_SWEEP_DIVISOR;
+            int touchedSize = 0;
+            for (int j = 0; j < (sweep ? n : frontierSize); ++j) {
+                int u = sweep ? j : frontierList[j];
+                unsigned long long bits = frontier[u];
+                if (bits == 0)
+                    continue;
+                frontier[u] = 0;
+                for (typename View::Cursor c = view.first(u); view.valid(c); view.advance(c)) {
+                    int v = view.target(c);
+                    if (!sweep && next[v] == 0)
+                        touched[touchedSize++] = v;
+                    next[v] |= bits;
+                }
+            }
+
+            int nextSize = 0;
+            for (int j = 0; j < (sweep ? n : touchedSize); ++j) {
+                int v = sweep ? j : touched[j];
+                if (next[v] == 0)
+                    continue;
+                unsigned long long fresh = next[v] & ~seen[v];
+                next[v] = 0;
+                if (fresh == 0)
+                    continue;
+                frontier[v] = fresh;
+                nextList[nextSize++] = v;
+                seen[v] |= fresh;
+                while (fresh != 0) {
+                    int i = __builtin_ctzll(fresh);
+                    batchDistances[static_cast<long long>(i) * n + v] = level;
+                    fresh &= fresh - 1;
+                }
+            }
+            int* swap = frontierList;
+            frontierList = nextList;
+            nextList = swap;
+            frontierSize = nextSize;
+        }
+    }
+
+    delete[] seen;
+    delete[] frontier;
+    delete[] next;
+    delete[] frontierList;
+    delete[] nextList;
+    delete[] touched;
+}
+
+// Bidirectional Dijkstra. A forward search from source and a backward search
+// from target (the graph is undirected, so both use the same adjacency) take
+// turns: each step settles the smaller of the two queue minimums. best is the
+// shortest source - target path seen so far, through the vertex meet, and is
+// updated whenever a vertex gets a distance from both sides. Once the two queue
+// minimums add up to at least best, no unsettled path can be shorter.
+// The labels and queues are result's SearchScratch, so a repeated query costs
+// only the vertices it labels, not O(n) to set them up.
+template <class View>
+void bidirectionalSearch(const View& view, int source, int target, PathResult& result) {
+    int n = view.numVertices();
+    if (source < 0 || source >= n || target < 0 || target >= n) {
+        throw std::out_of_range("Vertex " + std::to_string(source < 0 || source >= n ? source : target) +
+                                " is out of bounds");
+    }
+    result.reset(n);
+    if (source == target) {
+        result.distance = 0;
+        result.path[0] = source;
+        result.pathLength = 1;
+        return;
+    }
+
+    // Forward and backward labels, clear on entry and cleared again on the way out
+    SearchScratch& scratch = result.scratch();
+    scratch.prepare(n, 2);
+    int** distance = scratch.distance;
+    int** parent = scratch.parent;
+    PriorityQueue& forward = *scratch.queue[0];
+    PriorityQueue& backward = *scratch.queue[1];
+    PriorityQueue** queue = scratch.queue;
+    distance[0][source] = 0;
+    distance[1][target] = 0;
+    scratch.touch(source);
+    scratch.touch(target);
+    forward.insert(source, 0);
+    backward.insert(target, 0);
+
+    long long best = INT_MAX;
+    int meet = -1;
+    while (!forward.isEmpty() && !backward.isEmpty()) {
+        if (static_cast<long long>(forward.minPriority()) + backward.minPriority() >= best)
+            break;
+        int side = forward.minPriority() <= backward.minPriority() ? 0 : 1;
+        int* dist = distance[side];
+        int* other = distance[1 - side];
+
+        int u = queue[side]->extractMin();
+        ++result.settled;
+        for (typename View::Cursor c = view.first(u); view.valid(c); view.advance(c)) {
+            int v = view.target(c);
+            int weight = view.weight(c);
+            if (weight < 0) {
+                scratch.finish();
+                throw std::invalid_argument("Negative edge weight detected. Dijkstra cannot handle negative weights.");
+            }
+            if (dist[u] + weight < dist[v]) {
+                if (dist[v] == INT_MAX)
+                    scratch.touch(v);
+                dist[v] = dist[u] + weight;
+                parent[side][v] = u;
+                if (queue[side]->contains(v))
+                    queue[side]->decreasePriority(v, dist[v]);
+                else
+                    queue[side]->insert(v, dist[v]);
+
+                if (other[v] != INT_MAX && static_cast<long long>(dist[v]) + other[v] < best) {
+                    best = static_cast<long long>(dist[v]) + other[v];
+                    meet = v;
+                }
+            }
+        }
+    }
+
+    if (meet != -1) {
+        result.distance = static_cast<int>(best);
+        // source ... meet from the forward parents (collected backwards), then meet ... target
+        for (int v = meet; v != -1; v = parent[0][v]) {
+            result.path[result.pathLength++] = v;
+        }
+        for (int i = 0, j = result.pathLength - 1; i < j; ++i, --j) {
+            int temp = result.path[i];
+            result.path[i] = result.path[j];
+            result.path[j] = temp;
+        }
+        for (int v = parent[1][meet]; v != -1; v = parent[1][v]) {
+            result.path[result.pathLength++] = v;
+        }
+    }
+    scratch.finish();
 }
 
-}
\ No newline at end of file
+// Growable int array filled by a single worker thread,
+// nothing is allocated until the first push
+struct ThreadBuffer {
+    int* items;
+    int size;
+    int capacity;
+
+    ThreadBuffer() : items(nullptr), size(0), capacity(0) {}
+    ~ThreadBuffer() { delete[] items; }
+    ThreadBuffer(const ThreadBuffer&) = delete;
+    ThreadBuffer& operator=(const ThreadBuffer&) = delete;
+
+    void push(int value) {
+        if (size == capacity) {
+            int larger = capacity > 0 ? 2 * capacity : 64;
+            int* grown = new int[larger];
+            for (int i = 0; i < size; ++i) {
+                grown[i] = items[i];
+            }
+            delete[] items;
+            items = grown;
+            capacity = larger;
+        }
+        items[size++] = value;
+    }
+};
+
+// Frontiers smaller than this are expanded serially by parallelBfsSearch,
+// splitting them would cost more in synchronization than it saves
+static const int PARALLEL_BFS_MIN_FRONTIER = 4096;
+
+// Parallel level-synchronous BFS. Each level's frontier (a range of the order
+// array) is split across the threads. A thread claims an unvisited neighbor v
+// with one CAS of claim[v] from -1 to its own vertex, so every vertex gets
+// exactly one parent, and appends v to its private buffer. Each thread then
+// copies its buffer behind the frontier at its offset from a prefix sum, which
+// forms the next level without locks.
+// Levels with fewer than PARALLEL_BFS_MIN_FRONTIER vertices run on the calling
+// thread alone. A run of larger levels is handled by one team of threads that
+// stays alive across those levels, two barriers per level, and hands back to
+// the serial loop once the frontier shrinks again. Long paths and grids thus
+// never start threads at all.
+// Distances equal bfsSearch's; which frontier neighbor wins a vertex, and the
+// order within a level, depend on the thread timing.
+// Observer events are reported level by level on one thread afterwards.
+template <class View, class Obs>
+void parallelBfsSearch(const View& view, int start, int numThreads, TraversalResult& result, Obs& obs) {
+    int n = view.numVertices();
+    if (start < 0 || start >= n) {
+        throw std::out_of_range("Vertex " + std::to_string(start) + " is out of bounds");
+    }
+    result.reset(n, -1);
+    numThreads = resolveThreadCount(numThreads);
+
+    std::atomic<int>* claim = new std::atomic<int>[n]; // Parent of a claimed vertex, -1 if unvisited
+    int* treeWeight = Obs::enabled ? new int[n] : nullptr; // Weight of the claiming edge, for the observer
+    ThreadBuffer* buffers = new ThreadBuffer[numThreads];
+    int* counts = new int[numThreads];
+    for (int v = 0; v < n; ++v) {
+        claim[v].store(-1, std::memory_order_relaxed);
+    }
+    claim[start].store(start, std::memory_order_relaxed);
+
+    int* order = result.order;
+    int* distance = result.distance;
+    order[0] = start;
+    distance[start] = 0;
+    int levelBegin = 0;
+    int levelEnd = 1;
+    int level = 0;
+
+    // Claims v for u at depth level + 1, true if this call won it. Serial levels
+    // have no competing threads and skip the CAS.
+    auto claimVertex = [&](int u, typename View::Cursor c, int level, bool serial) {
+        int v = view.target(c);
+        int unvisited = -1;
+        if (claim[v].load(std::memory_order_relaxed) != -1)
+            return false;
+        if (serial)
+            claim[v].store(u, std::memory_order_relaxed);
+        else if (!claim[v].compare_exchange_strong(unvisited, u, std::memory_order_relaxed))
+            return false;
+        distance[v] = level + 1;
+        result.parent[v] = u;
+        result.weight[v] = level + 1;
+        if (Obs::enabled)
+            treeWeight[v] = view.weight(c);
+        return true;
+    };
+
+    while (levelBegin < levelEnd) {
+        if (numThreads == 1 || levelEnd - levelBegin < PARALLEL_BFS_MIN_FRONTIER) {
+            int next = levelEnd;
+            for (int i = levelBegin; i < levelEnd; ++i) {
+                int u = order[i];
+                for (typename View::Cursor c = view.first(u); view.valid(c); view.advance(c)) {
+                    if (claimVertex(u, c, level, true))
+                        order[next++] = view.target(c);
+                }
+            }
+            levelBegin = levelEnd;
+            levelEnd = next;
+            ++level;
+            continue;
+        }
+
+        // Every thread works on its own copy of the level bounds. They all compute
+        // the same values from counts, so they leave the loop after the same level,
+        // and thread 0 writes the bounds back. The loop runs at least once, so all
+        // copies are taken before the first barrier and thread 0's write.
+        Barrier barrier(numThreads);
+        parallelTeam(numThreads, barrier, [&](int t) {
+            int begin = levelBegin;
+            int end = levelEnd;
+            int depth = level;
+            while (end - begin >= PARALLEL_BFS_MIN_FRONTIER) {
+                ThreadBuffer& local = buffers[t];
+                local.size = 0;
+                int last = begin + chunkBegin(end - begin, t + 1, numThreads);
+                for (int i = begin + chunkBegin(end - begin, t, numThreads); i < last; ++i) {
+                    int u = order[i];
+                    for (typename View::Cursor c = view.first(u); view.valid(c); view.advance(c)) {
+                        if (claimVertex(u, c, depth, false))
+                            local.push(view.target(c));
+                    }
+                }
+                counts[t] = local.size;
+                barrier.wait();
+
+                int offset = end;
+                int next = end;
+                for (int other = 0; other < numThreads; ++other) {
+                    if (other < t)
+                        offset += counts[other];
+                    next += counts[other];
+                }
+                for (int i = 0; i < local.size; ++i) {
+                    order[offset + i] = local.items[i];
+                }
+                begin = end;
+                end = next;
+                ++depth;
+                barrier.wait(); // The next level reads order and overwrites counts
+            }
+            if (t == 0) {
+                levelBegin = begin;
+                levelEnd = end;
+                level = depth;
+            }
+        });
+    }
+    result.orderCount = levelEnd;
+
+    if (Obs::enabled) {
+        for (int i = 0; i < levelEnd; ++i) {
+            int v = order[i];
+            obs.vertexSettled(v);
+            if (v != start)
+                obs.treeEdgeAdded(result.parent[v], v, treeWeight[v]);
+        }
+    }
+
+    delete[] claim;
+    delete[] treeWeight;
+    delete[] buffers;
+    delete[] counts;
+}
+
+// Packed (distance, parent) of a vertex for delta-stepping: the distance in the
+// high 32 bits and the parent in the low 32, so one CAS updates both together
+inline unsigned long long packPath(long long distance, int parent) {
+    return (static_cast<unsigned long long>(distance) << 32) | static_cast<unsigned int>(parent);
+}
+
+const unsigned long long UNREACHED_PATH = packPath(INT_MAX, -1);
+
+// Replaces target by key if key has a strictly smaller distance, true if it did.
+// Equal distances keep the old parent: with zero weight edges, switching parents
+// on ties could close a cycle in the tree.
+inline bool relaxPath(std::atomic<unsigned long long>& target, unsigned long long key) {
+    unsigned long long current = target.load(std::memory_order_relaxed);
+    while ((key >> 32) < (current >> 32)) {
+        if (target.compare_exchange_weak(current, key, std::memory_order_relaxed))
+            return true;
+    }
+    return false;
+}
+
+// Light iterations and heavy phases over fewer vertices run on one thread in deltaSteppingSearch
+static const int DELTA_STEPPING_MIN_FRONTIER = 1024;
+
+// Parallel delta-stepping SSSP (Meyer and Sanders). Tentative distances are
+// grouped into buckets of width delta and the buckets are processed in order:
+// 1. Light phase: the bucket's vertices relax their light edges (weight <= delta)
+//    in parallel. These can refill the same bucket, so this repeats until the
+//    bucket stays empty. The vertices expanded in it are now final.
+// 2. Heavy phase: the final vertices of the bucket relax their heavy edges in
+//    parallel, which can only reach later buckets.
+// Every relaxation is one atomic min on the packed (distance, parent) word, and
+// a thread that lowers a distance pushes the vertex into its own copy of the
+// target bucket. Pending buckets never lie more than maxWeight / delta + 1 past
+// the current one, so each thread keeps that many buckets in a ring.
+// The threads are started once per search and the phases are separated by
+// barriers, so a query with thousands of light iterations starts no more threads.
+// Small steps run on one thread without any barrier.
+// A vertex's parent is the vertex whose relaxation set its final distance, and
+// that relaxation used the parent's own final distance, so the parents form a
+// shortest-path tree. Which of several equal predecessors wins depends on the
+// thread timing. The order array lists vertices bucket by bucket.
+template <class View, class Obs>
+void deltaSteppingSearch(const View& view, int start, int delta, int numThreads, TraversalResult& result, Obs& obs) {
+    int n = view.numVertices();
+    if (start < 0 || start >= n) {
+        throw std::out_of_range("Start vertex " + std::to_string(start) + " is out of bounds");
+    }
+
+    // One pass for negative weights, the largest weight and the default delta
+    int maxWeight = 0;
+    for (int u = 0; u < n; ++u) {
+        for (typename View::Cursor c = view.first(u); view.valid(c); view.advance(c)) {
+            int weight = view.weight(c);
+            if (weight < 0) {
+                throw std::invalid_argument("Negative edge weight detected. Delta-stepping cannot handle negative weights.");
+            }
+            if (weight > maxWeight)
+                maxWeight = weight;
+        }
+    }
+    if (delta <= 0) {
+        long long averageDegree = view.numEntries() / n;
+        delta = static_cast<int>(maxWeight / (averageDegree > 0 ? averageDegree : 1));
+        if (delta < 1)
+            delta = 1;
+    }
+
+    result.reset(n, INT_MAX);
+    numThreads = resolveThreadCount(numThreads);
+    int numSlots = maxWeight / delta + 2; // Bucket b lives in slot b % numSlots
+
+    std::atomic<unsigned long long>* path = new std::atomic<unsigned long long>[n];
+    std::atomic<int>* expanded = new std::atomic<int>[n]; // Distance a vertex was last expanded with
+    ThreadBuffer* bins = new ThreadBuffer[static_cast<long long>(numThreads) * numSlots];
+    ThreadBuffer* settled = new ThreadBuffer[numThreads];
+    int frontierCapacity = 64;
+    int* frontier = new int[frontierCapacity];
+    for (int v = 0; v < n; ++v) {
+        path[v].store(UNREACHED_PATH, std::memory_order_relaxed);
+        expanded[v].store(-1, std::memory_order_relaxed);
+    }
+    path[start].store(packPath(0, -1), std::memory_order_relaxed);
+    frontier[0] = start;
+    int frontierSize = 1;
+
+    long long current = 0; // Bucket being processed
+    int bucketBegin = 0;   // Start of its settled vertices in the order array
+    bool done = false;
+
+    auto relax = [&](int t, int u, long long d, int v, int weight) {
+        long long candidate = d + weight;
+        if (candidate < INT_MAX && relaxPath(path[v], packPath(candidate, u)))
+            bins[static_cast<long long>(t) * numSlots + (candidate / delta) % numSlots].push(v);
+    };
+
+    // Moves every thread's copy of a bucket into frontier, on one thread: it only
+    // copies, and splitting it would cost a barrier more than the copy itself
+    auto gather = [&](int slot) {
+        int total = 0;
+        for (int t = 0; t < numThreads; ++t) {
+            total += bins[static_cast<long long>(t) * numSlots + slot].size;
+        }
+        if (total > frontierCapacity) {
+            delete[] frontier;
+            frontierCapacity = total;
+            frontier = new int[frontierCapacity];
+        }
+        frontierSize = 0;
+        for (int t = 0; t < numThreads; ++t) {
+            ThreadBuffer& bin = bins[static_cast<long long>(t) * numSlots + slot];
+            for (int i = 0; i < bin.size; ++i) {
+                frontier[frontierSize++] = bin.items[i];
+            }
+            bin.size = 0;
+        }
+    };
+
+    // Light relaxations of frontier[begin, end) by thread t
+    auto lightPhase = [&](int t, int begin, int end) {
+        for (int i = begin; i < end; ++i) {
+            int u = frontier[i];
+            long long d = static_cast<long long>(path[u].load(std::memory_order_relaxed) >> 32);
+            if (d / delta != current)
+                continue; // Improved into an earlier bucket and expanded there
+            int previous = expanded[u].exchange(static_cast<int>(d), std::memory_order_relaxed);
+            if (previous == d)
+                continue; // Pushed more than once with this distance
+            if (previous == -1)
+                settled[t].push(u);
+            for (typename View::Cursor c = view.first(u); view.valid(c); view.advance(c)) {
+                if (view.weight(c) <= delta)
+                    relax(t, u, d, view.target(c), view.weight(c));
+            }
+        }
+    };
+
+    // Heavy relaxations of the bucket's settled vertices order[begin, end) by thread t
+    auto heavyPhase = [&](int t, int begin, int end) {
+        for (int i = begin; i < end; ++i) {
+            int u = result.order[i];
+            long long d = static_cast<long long>(path[u].load(std::memory_order_relaxed) >> 32);
+            for (typename View::Cursor c = view.first(u); view.valid(c); view.advance(c)) {
+                if (view.weight(c) > delta)
+                    relax(t, u, d, view.target(c), view.weight(c));
+            }
+        }
+    };
+
+    // Appends the vertices settled in the current bucket to the order array
+    auto appendSettled = [&]() {
+        bucketBegin = result.orderCount;
+        for (int t = 0; t < numThreads; ++t) {
+            for (int i = 0; i < settled[t].size; ++i) {
+                result.order[result.orderCount++] = settled[t].items[i];
+            }
+            settled[t].size = 0;
+        }
+    };
+
+    // Moves on to the first non-empty bucket in the ring, done if there is none
+    auto nextBucket = [&]() {
+        for (int step = 1; step < numSlots; ++step) {
+            int slot = static_cast<int>((current + step) % numSlots);
+            for (int t = 0; t < numThreads; ++t) {
+                if (bins[static_cast<long long>(t) * numSlots + slot].size > 0) {
+                    current += step;
+                    gather(slot);
+                    return;
+                }
+            }
+        }
+        done = true;
+    };
+
+    // One team runs the whole search. Thread 0 advances it alone as long as the
+    // steps are small: light iterations over fewer than DELTA_STEPPING_MIN_FRONTIER
+    // vertices and heavy phases of as few settled vertices. The others wait at the
+    // barrier until a larger step comes up, which the whole team then splits. Thread
+    // 0 writes the shared state (frontier, current, done) only while the others
+    // wait, so it is only read after the barrier.
+    bool heavyStep = false; // Kind of the next team step: light iteration or heavy phase
+    Barrier barrier(numThreads);
+    parallelTeam(numThreads, barrier, [&](int t) {
+        while (true) {
+            if (t == 0) {
+                while (!done) {
+                    if (frontierSize > 0) {
+                        if (numThreads > 1 && frontierSize >= DELTA_STEPPING_MIN_FRONTIER) {
+                            heavyStep = false;
+                            break;
+                        }
+                        lightPhase(0, 0, frontierSize);
+                        gather(static_cast<int>(current % numSlots));
+                        continue;
+                    }
+                    appendSettled();
+                    if (numThreads > 1 && result.orderCount - bucketBegin >= DELTA_STEPPING_MIN_FRONTIER) {
+                        heavyStep = true;
+                        break;
+                    }
+                    heavyPhase(0, bucketBegin, result.orderCount);
+                    nextBucket();
+                }
+            }
+            barrier.wait();
+            if (done)
+                break;
+
+            if (heavyStep) {
+                int count = result.orderCount - bucketBegin;
+                heavyPhase(t, bucketBegin + chunkBegin(count, t, numThreads), bucketBegin + chunkBegin(count, t + 1, numThreads));
+            } else {
+                lightPhase(t, chunkBegin(frontierSize, t, numThreads), chunkBegin(frontierSize, t + 1, numThreads));
+            }
+            barrier.wait();
+            if (t == 0) {
+                if (heavyStep)
+                    nextBucket();
+                else
+                    gather(static_cast<int>(current % numSlots));
+            }
+        }
+    });
+
+    for (int v = 0; v < n; ++v) {
+        unsigned long long packed = path[v].load(std::memory_order_relaxed);
+        result.distance[v] = static_cast<int>(packed >> 32);
+        result.parent[v] = static_cast<int>(static_cast<unsigned int>(packed & 0xFFFFFFFFu));
+    }
+    // A tree edge's weight is exactly the distance it adds
+    for (int v = 0; v < n; ++v) {
+        if (result.parent[v] != -1)
+            result.weight[v] = result.distance[v] - result.distance[result.parent[v]];
+    }
+    for (int i = 0; i < result.orderCount; ++i) {
+        int v = result.order[i];
+        obs.vertexSettled(v);
+        if (result.parent[v] != -1)
+            obs.treeEdgeAdded(result.parent[v], v, result.weight[v]);
+    }
+
+    delete[] path;
+    delete[] expanded;
+    delete[] bins;
+    delete[] settled;
+    delete[] frontier;
+}
+
+// Parallel connected components: threads unite the endpoints of their share
+// of the adjacency entries in one ConcurrentUnionFind, then every vertex is
+// labeled with a dense component id in order of the smallest vertex.
+template <class View>
+int componentsSearch(const View& view, int* label, int numThreads) {
+    int n = view.numVertices();
+    numThreads = resolveThreadCount(numThreads);
+    ConcurrentUnionFind uf(n);
+
+    parallelChunks(n, numThreads, [&](int, int begin, int end) {
+        for (int u = begin; u < end; ++u) {
+            for (typename View::Cursor c = view.first(u); view.valid(c); view.advance(c)) {
+                int v = view.target(c);
+                if (u < v)
+                    uf.unite(u, v);
+            }
+        }
+    });
+
+    // Dense ids in order of each component's smallest vertex
+    int* id = new int[n];
+    for (int v = 0; v < n; ++v) {
+        id[v] = -1;
+    }
+    int count = 0;
+    for (int v = 0; v < n; ++v) {
+        int root = uf.find(v);
+        if (id[root] == -1)
+            id[root] = count++;
+        label[v] = id[root];
+    }
+    delete[] id;
+    return count;
+}
+
+// Offline dynamic connectivity, divide and conquer over time.
+// Replaying the timeline turns every edge into the range of queries [first, last)
+// during which it exists. A range is stored at the O(log Q) nodes of a segment
+// tree over the Q queries that exactly cover it. answer() walks the tree depth
+// first, uniting a node's edges on the way down and rolling them back on the
+// way up, so at each leaf the union-find holds exactly the edges alive at that
+// query: O((V + E) log Q log V) in total.
+class ConnectivityTimeline {
+private:
+    int numVertices;
+    Edge* edges;     // Endpoints of every edge range
+    int* first;      // Range of queries [first[i], last[i]) during which edge i exists
+    int* last;
+    int edgeCount;
+    Edge* queries;   // Endpoints of every query in timeline order
+    int numQueries;
+    int* nodeStart;  // Edges of tree node t are nodeEdges[nodeStart[t] .. nodeStart[t + 1])
+    Edge* nodeEdges;
+
+    // Calls visit(t) for the tree nodes whose query ranges exactly cover [from, to)
+    template <class Visit>
+    void cover(int t, int lo, int hi, int from, int to, Visit& visit) {
+        if (to <= lo || hi <= from)
+            return;
+        if (from <= lo && hi <= to) {
+            visit(t);
+            return;
+        }
+        int mid = lo + (hi - lo) / 2;
+        cover(2 * t + 1, lo, mid, from, to, visit);
+        cover(2 * t + 2, mid, hi, from, to, visit);
+    }
+
+    void openEdge(Graph& live, int u, int v) {
+        live.addEdge(u, v, edgeCount); // The weight remembers the range of the edge
+        edges[edgeCount] = {u, v, 0};
+        first[edgeCount] = numQueries;
+        last[edgeCount] = -1;
+        ++edgeCount;
+    }
+
+public:
+    ConnectivityTimeline(const Graph& g, const ConnectivityEvent* events, int numEvents)
+        : numVertices(g.getNumVertices()), edges(nullptr), first(nullptr), last(nullptr), edgeCount(0),
+          queries(nullptr), numQueries(0), nodeStart(nullptr), nodeEdges(nullptr) {
+        int capacity = 0;
+        int queryCapacity = 0;
+        for (int u = 0; u < numVertices; ++u) {
+            for (Node* p = g.getAdjList(u); p != nullptr; p = p->next) {
+                if (u < p->vertex)
+                    ++capacity;
+            }
+        }
+        for (int i = 0; i < numEvents; ++i) {
+            if (events[i].type == InsertEdge)
+                ++capacity;
+            else if (events[i].type == ConnectedQuery)
+                ++queryCapacity;
+        }
+        edges = new Edge[capacity];
+        first = new int[capacity];
+        last = new int[capacity];
+        queries = new Edge[queryCapacity];
+    }
+
+    ~ConnectivityTimeline() {
+        delete[] edges;
+        delete[] first;
+        delete[] last;
+        delete[] queries;
+        delete[] nodeStart;
+        delete[] nodeEdges;
+    }
+
+    ConnectivityTimeline(const ConnectivityTimeline&) = delete;
+    ConnectivityTimeline& operator=(const ConnectivityTimeline&) = delete;
+
+    int queryCount() const { return numQueries; }
+
+    // Replays the timeline on a working copy of the edge set. Graph's own checks
+    // reject inserting an existing edge, deleting a missing one and self-loops.
+    void replay(const Graph& g, const ConnectivityEvent* events, int numEvents) {
+        Graph live(numVertices);
+        for (int u = 0; u < numVertices; ++u) {
+            for (Node* p = g.getAdjList(u); p != nullptr; p = p->next) {
+                if (u < p->vertex)
+                    openEdge(live, u, p->vertex);
+            }
+        }
+
+        for (int i = 0; i < numEvents; ++i) {
+            int u = events[i].u;
+            int v = events[i].v;
+            if (events[i].type == InsertEdge) {
+                openEdge(live, u, v);
+            } else if (events[i].type == DeleteEdge) {
+                Node* entry = live.findEdge(u, v);
+                int id = entry != nullptr ? entry->weight : -1;
+                live.removeEdge(u, v);
+                last[id] = numQueries;
+            } else {
+                if (u < 0 || u >= numVertices || v < 0 || v >= numVertices)
+                    throw std::out_of_range("Invalid vertex index");
+                queries[numQueries++] = {u, v, 0};
+            }
+        }
+
+        for (int i = 0; i < edgeCount; ++i) {
+            if (last[i] == -1)
+                last[i] = numQueries; // Never deleted, alive until the end
+        }
+    }
+
+    // Distributes the edge ranges over the segment tree nodes (counting pass, then fill)
+    void build() {
+        if (numQueries == 0)
+            return;
+        int nodeCount = 4 * numQueries;
+        nodeStart = new int[nodeCount + 1]();
+
+        auto count = [&](int t) { ++nodeStart[t + 1]; };
+        for (int i = 0; i < edgeCount; ++i) {
+            cover(0, 0, numQueries, first[i], last[i], count);
+        }
+        for (int t = 0; t < nodeCount; ++t) {
+            nodeStart[t + 1] += nodeStart[t];
+        }
+
+        nodeEdges = new Edge[nodeStart[nodeCount]];
+        int* fill = new int[nodeCount];
+        for (int t = 0; t < nodeCount; ++t) {
+            fill[t] = nodeStart[t];
+        }
+        int current = 0;
+        auto place = [&](int t) { nodeEdges[fill[t]++] = edges[current]; };
+        for (current = 0; current < edgeCount; ++current) {
+            cover(0, 0, numQueries, first[current], last[current], place);
+        }
+        delete[] fill;
+    }
+
+    void answer(int t, int lo, int hi, RollbackUnionFind& uf, bool* answers) {
+        int mark = uf.snapshot();
+        for (int i = nodeStart[t]; i < nodeStart[t + 1]; ++i) {
+            uf.unite(nodeEdges[i].from, nodeEdges[i].to);
+        }
+
+        if (uf.numSets() == 1) {
+            // Everything is connected, so is every query below this node
+            for (int q = lo; q < hi; ++q) {
+                answers[q] = true;
+            }
+        } else if (hi - lo == 1) {
+            answers[lo] = uf.find(queries[lo].from) == uf.find(queries[lo].to);
+        } else {
+            int mid = lo + (hi - lo) / 2;
+            answer(2 * t + 1, lo, mid, uf, answers);
+            answer(2 * t + 2, mid, hi, uf, answers);
+        }
+        uf.rollback(mark);
+    }
+};
+
+// Runs search with the caller's observer, or with NullObserver when there is none
+// so that unobserved runs contain no hook calls at all
+template <class Search>
+void withObserver(AlgorithmObserver* observer, Search search) {
+    if (observer != nullptr) {
+        ForwardingObserver forward{*observer};
+        search(forward);
+    } else {
+        NullObserver none;
+        search(none);
+    }
+}
+
+} // namespace
+
+
+// ============ Traversal Result =======
+
+TraversalResult::TraversalResult()
+    : numVertices(0), parent(nullptr), weight(nullptr), distance(nullptr), order(nullptr), orderCount(0),
+      sparse(false), sparseUnreached(0), searchScratch(nullptr) {}
+
+TraversalResult::TraversalResult(int vertices) : TraversalResult() {
+    reset(vertices, -1);
+}
+
+TraversalResult::TraversalResult(const TraversalResult& other) : TraversalResult() {
+    copyFrom(other);
+}
+
+TraversalResult& TraversalResult::operator=(const TraversalResult& other) {
+    if (this == &other)
+        return *this;
+    copyFrom(other);
+    return *this;
+}
+
+TraversalResult::TraversalResult(TraversalResult&& other) noexcept
+    : numVertices(other.numVertices), parent(other.parent), weight(other.weight), distance(other.distance),
+      order(other.order), orderCount(other.orderCount), sparse(other.sparse), sparseUnreached(other.sparseUnreached),
+      searchScratch(other.searchScratch) {
+    other.numVertices = 0;
+    other.parent = nullptr;
+    other.weight = nullptr;
+    other.distance = nullptr;
+    other.order = nullptr;
+    other.orderCount = 0;
+    other.sparse = false;
+    other.searchScratch = nullptr;
+}
+
+TraversalResult& TraversalResult::operator=(TraversalResult&& other) noexcept {
+    if (this == &other)
+        return *this;
+
+    release();
+    delete searchScratch;
+    numVertices = other.numVertices;
+    parent = other.parent;
+    weight = other.weight;
+    distance = other.distance;
+    order = other.order;
+    orderCount = other.orderCount;
+    sparse = other.sparse;
+    sparseUnreached = other.sparseUnreached;
+    searchScratch = other.searchScratch;
+    other.numVertices = 0;
+    other.parent = nullptr;
+    other.weight = nullptr;
+    other.distance = nullptr;
+    other.order = nullptr;
+    other.orderCount = 0;
+    other.sparse = false;
+    other.searchScratch = nullptr;
+
+    return *this;
+}
+
+TraversalResult::~TraversalResult() {
+    release();
+    delete searchScratch;
+}
+
+void TraversalResult::allocate(int vertices) {
+    if (vertices == numVertices)
+        return;
+    release();
+    numVertices = vertices;
+    parent = new int[vertices];
+    weight = new int[vertices];
+    distance = new int[vertices];
+    order = new int[vertices];
+}
+
+void TraversalResult::release() {
+    delete[] parent;
+    delete[] weight;
+    delete[] distance;
+    delete[] order;
+    parent = weight = distance = order = nullptr;
+    numVertices = 0;
+    orderCount = 0;
+}
+
+void TraversalResult::copyFrom(const TraversalResult& other) {
+    allocate(other.numVertices);
+    for (int i = 0; i < numVertices; ++i) {
+        parent[i] = other.parent[i];
+        weight[i] = other.weight[i];
+        distance[i] = other.distance[i];
+    }
+    for (int i = 0; i < other.orderCount; ++i) {
+        order[i] = other.order[i];
+    }
+    orderCount = other.orderCount;
+    sparse = other.sparse;
+    sparseUnreached = other.sparseUnreached;
+}
+
+void TraversalResult::reset(int vertices, int unreached) {
+    if (vertices <= 0) {
+        throw std::invalid_argument("Number of vertices must be positive");
+    }
+    allocate(vertices);
+    for (int i = 0; i < numVertices; ++i) {
+        parent[i] = -1;
+        weight[i] = 0;
+        distance[i] = unreached;
+    }
+    orderCount = 0;
+    sparse = false;
+}
+
+void TraversalResult::resetSparse(int vertices, int unreached) {
+    if (!sparse || vertices != numVertices || unreached != sparseUnreached) {
+        reset(vertices, unreached);
+        return;
+    }
+    for (int i = 0; i < orderCount; ++i) {
+        int v = order[i];
+        parent[v] = -1;
+        weight[v] = 0;
+        distance[v] = unreached;
+    }
+    orderCount = 0;
+    sparse = false;
+}
+
+void TraversalResult::markSparse(int unreached) {
+    sparse = true;
+    sparseUnreached = unreached;
+}
+
+SearchScratch& TraversalResult::scratch() {
+    if (searchScratch == nullptr)
+        searchScratch = new SearchScratch();
+    return *searchScratch;
+}
+
+Graph TraversalResult::toGraph() const {
+    if (numVertices <= 0) {
+        throw std::logic_error("Empty traversal result");
+    }
+    Graph tree(numVertices);
+    tree.initializeVisitOrder();
+
+    for (int i = 0; i < orderCount; ++i) {
+        int v = order[i];
+        if (parent[v] != -1) {
+            tree.addEdge(parent[v], v, weight[v]);
+        }
+        tree.setVisitOrder(i, v);
+    }
+
+    return tree;
+}
+
+// ============ Coordinate Table =======
+
+CoordinateTable::CoordinateTable(int vertices) : numVertices(vertices), xs(nullptr), ys(nullptr) {
+    if (vertices <= 0) {
+        throw std::invalid_argument("Number of vertices must be positive");
+    }
+    xs = new double[vertices]();
+    ys = new double[vertices]();
+}
+
+CoordinateTable::CoordinateTable(const CoordinateTable& other) : numVertices(0), xs(nullptr), ys(nullptr) {
+    copyFrom(other);
+}
+
+CoordinateTable& CoordinateTable::operator=(const CoordinateTable& other) {
+    if (this == &other)
+        return *this;
+    copyFrom(other);
+    return *this;
+}
+
+CoordinateTable::CoordinateTable(CoordinateTable&& other) noexcept
+    : numVertices(other.numVertices), xs(other.xs), ys(other.ys) {
+    other.numVertices = 0;
+    other.xs = nullptr;
+    other.ys = nullptr;
+}
+
+CoordinateTable& CoordinateTable::operator=(CoordinateTable&& other) noexcept {
+    if (this == &other)
+        return *this;
+
+    delete[] xs;
+    delete[] ys;
+    numVertices = other.numVertices;
+    xs = other.xs;
+    ys = other.ys;
+    other.numVertices = 0;
+    other.xs = nullptr;
+    other.ys = nullptr;
+
+    return *this;
+}
+
+CoordinateTable::~CoordinateTable() {
+    delete[] xs;
+    delete[] ys;
+}
+
+void CoordinateTable::copyFrom(const CoordinateTable& other) {
+    if (numVertices != other.numVertices) {
+        delete[] xs;
+        delete[] ys;
+        numVertices = other.numVertices;
+        xs = new double[numVertices];
+        ys = new double[numVertices];
+    }
+    for (int v = 0; v < numVertices; ++v) {
+        xs[v] = other.xs[v];
+        ys[v] = other.ys[v];
+    }
+}
+
+void CoordinateTable::set(int v, double x, double y) {
+    if (v < 0 || v >= numVertices) {
+        throw std::out_of_range("Vertex " + std::to_string(v) + " is out of bounds");
+    }
+    xs[v] = x;
+    ys[v] = y;
+}
+
+// ============ Path Result =======
+
+PathResult::PathResult()
+    : distance(INT_MAX), path(nullptr), pathLength(0), settled(0), capacity(0), searchScratch(nullptr) {}
+
+PathResult::PathResult(const PathResult& other) : PathResult() {
+    copyFrom(other);
+}
+
+PathResult& PathResult::operator=(const PathResult& other) {
+    if (this == &other)
+        return *this;
+    copyFrom(other);
+    return *this;
+}
+
+PathResult::PathResult(PathResult&& other) noexcept
+    : distance(other.distance), path(other.path), pathLength(other.pathLength), settled(other.settled),
+      capacity(other.capacity), searchScratch(other.searchScratch) {
+    other.path = nullptr;
+    other.capacity = 0;
+    other.searchScratch = nullptr;
+    other.distance = INT_MAX;
+    other.pathLength = 0;
+    other.settled = 0;
+}
+
+PathResult& PathResult::operator=(PathResult&& other) noexcept {
+    if (this == &other)
+        return *this;
+
+    release();
+    delete searchScratch;
+    distance = other.distance;
+    path = other.path;
+    pathLength = other.pathLength;
+    settled = other.settled;
+    capacity = other.capacity;
+    searchScratch = other.searchScratch;
+    other.path = nullptr;
+    other.capacity = 0;
+    other.searchScratch = nullptr;
+    other.distance = INT_MAX;
+    other.pathLength = 0;
+    other.settled = 0;
+
+    return *this;
+}
+
+PathResult::~PathResult() {
+    release();
+    delete searchScratch;
+}
+
+void PathResult::release() {
+    delete[] path;
+    path = nullptr;
+    capacity = 0;
+}
+
+void PathResult::copyFrom(const PathResult& other) {
+    reset(other.capacity > 0 ? other.capacity : 1);
+    for (int i = 0; i < other.pathLength; ++i) {
+        path[i] = other.path[i];
+    }
+    distance = other.distance;
+    pathLength = other.pathLength;
+    settled = other.settled;
+}
+
+void PathResult::reset(int vertices) {
+    if (vertices <= 0) {
+        throw std::invalid_argument("Number of vertices must be positive");
+    }
+    if (vertices > capacity) {
+        release();
+        path = new int[vertices];
+        capacity = vertices;
+    }
+    distance = INT_MAX;
+    pathLength = 0;
+    settled = 0;
+}
+
+SearchScratch& PathResult::scratch() {
+    if (searchScratch == nullptr)
+        searchScratch = new SearchScratch();
+    return *searchScratch;
+}
+
+// ============ Search Scratch =======
+
+SearchScratch::SearchScratch()
+    : distance{nullptr, nullptr}, parent{nullptr, nullptr}, queue{nullptr, nullptr}, flag(nullptr), numVertices(0),
+      sides(0), queues(0), touched(nullptr), touchedCount(0), active(false) {}
+
+SearchScratch::~SearchScratch() {
+    release();
+}
+
+void SearchScratch::release() {
+    for (int side = 0; side < 2; ++side) {
+        delete[] distance[side];
+        delete[] parent[side];
+        delete queue[side];
+        distance[side] = parent[side] = nullptr;
+        queue[side] = nullptr;
+    }
+    delete[] flag;
+    delete[] touched;
+    flag = nullptr;
+    touched = nullptr;
+    numVertices = 0;
+    sides = 0;
+    queues = 0;
+    touchedCount = 0;
+}
+
+// Every allocated label back to clear, used when a query did not reach finish()
+void SearchScratch::clearAll() {
+    for (int side = 0; side < sides; ++side) {
+        for (int v = 0; v < numVertices; ++v) {
+            distance[side][v] = INT_MAX;
+            parent[side][v] = -1;
+        }
+    }
+    for (int side = 0; side < queues; ++side) {
+        queue[side]->clear();
+    }
+    for (int v = 0; v < numVertices; ++v) {
+        flag[v] = false;
+    }
+    touchedCount = 0;
+}
+
+void SearchScratch::prepare(int vertices, int sidesNeeded) {
+    if (vertices <= 0) {
+        throw std::invalid_argument("Number of vertices must be positive");
+    }
+    if (sidesNeeded < 0 || sidesNeeded > 2) {
+        throw std::invalid_argument("A search has at most two directions");
+    }
+    if (vertices != numVertices) {
+        release();
+        numVertices = vertices;
+        touched = new int[2 * static_cast<long long>(vertices)];
+        flag = new bool[vertices]();
+        active = false;
+    } else if (active) {
+        clearAll();
+    }
+    for (; sides < sidesNeeded; ++sides) {
+        distance[sides] = new int[vertices];
+        parent[sides] = new int[vertices];
+        for (int v = 0; v < vertices; ++v) {
+            distance[sides][v] = INT_MAX;
+            parent[sides][v] = -1;
+        }
+    }
+    for (; queues < sidesNeeded || queues == 0; ++queues) {
+        queue[queues] = new PriorityQueue(vertices);
+    }
+    active = true;
+}
+
+void SearchScratch::finish() {
+    for (int i = 0; i < touchedCount; ++i) {
+        int v = touched[i];
+        for (int side = 0; side < sides; ++side) {
+            distance[side][v] = INT_MAX;
+            parent[side][v] = -1;
+        }
+    }
+    for (int side = 0; side < queues; ++side) {
+        queue[side]->clear();
+    }
+    touchedCount = 0;
+    active = false;
+}
+
+
+/**
+ * @brief Performs Breadth-First Search (BFS) on a graph starting from a given vertex.
+ * @param g The input graph.
+ * @param start The starting vertex for the BFS.
+ * @param observer Optional hooks called while the search runs.
+ * @return A BFS tree containing only the edges traversed by the BFS algorithm.
+ */
+Graph Algorithms::bfs(const Graph& g, int start, AlgorithmObserver* observer) {
+    TraversalResult result;
+    bfs(g, start, result, observer);
+    return result.toGraph();
+}
+
+/**
+ * @brief BFS on the CSR form of a graph, same result as bfs on the original Graph.
+ */
+Graph Algorithms::bfs(const CSRGraph& g, int start, AlgorithmObserver* observer) {
+    TraversalResult result;
+    bfs(g, start, result, observer);
+    return result.toGraph();
+}
+
+/**
+ * @brief BFS writing parents, hop distances and visit order into result.
+ * @param g The input graph.
+ * @param start The starting vertex for the BFS.
+ * @param result Output, reset to the number of vertices of g.
+ * @param observer Optional hooks called while the search runs.
+ */
+void Algorithms::bfs(const Graph& g, int start, TraversalResult& result, AlgorithmObserver* observer) {
+    withObserver(observer, [&](auto& obs) { bfsSearch(ListView(g), start, result, obs); });
+}
+
+void Algorithms::bfs(const CSRGraph& g, int start, TraversalResult& result, AlgorithmObserver* observer) {
+    withObserver(observer, [&](auto& obs) { bfsSearch(CSRView(g), start, result, obs); });
+}
+
+
+/**
+ * @brief BFS with a selectable expansion strategy.
+ * TopDown is the classic queue BFS above. DirectionOptimizing switches between
+ * top-down and bottom-up levels by frontier size, which examines far fewer edges
+ * on low-diameter graphs. Both give the same distances and visit the same
+ * vertices level by level; the parents (and the order within a level) may differ
+ * where a vertex has several neighbors on the previous level.
+ * @param g The input graph.
+ * @param start The starting vertex for the BFS.
+ * @param mode TopDown or DirectionOptimizing.
+ * @param observer Optional hooks called while the search runs.
+ * @return A BFS tree.
+ */
+Graph Algorithms::bfs(const Graph& g, int start, BfsMode mode, AlgorithmObserver* observer) {
+    TraversalResult result;
+    bfs(g, start, mode, result, observer);
+    return result.toGraph();
+}
+
+Graph Algorithms::bfs(const CSRGraph& g, int start, BfsMode mode, AlgorithmObserver* observer) {
+    TraversalResult result;
+    bfs(g, start, mode, result, observer);
+    return result.toGraph();
+}
+
+void Algorithms::bfs(const Graph& g, int start, BfsMode mode, TraversalResult& result, AlgorithmObserver* observer) {
+    withObserver(observer, [&](auto& obs) {
+        if (mode == DirectionOptimizing)
+            directionOptimizingBfsSearch(ListView(g), start, result, obs);
+        else
+            bfsSearch(ListView(g), start, result, obs);
+    });
+}
+
+void Algorithms::bfs(const CSRGraph& g, int start, BfsMode mode, TraversalResult& result, AlgorithmObserver* observer) {
+    withObserver(observer, [&](auto& obs) {
+        if (mode == DirectionOptimizing)
+            directionOptimizingBfsSearch(CSRView(g), start, result, obs);
+        else
+            bfsSearch(CSRView(g), start, result, obs);
+    });
+}
+
+/**
+ * @brief Performs Depth-First Search (DFS) on a graph starting from a given vertex.
+ * @param g The input graph.
+ * @param start The starting vertex for the DFS.
+ * @param observer Optional hooks called while the search runs.
+ * @return A DFS tree or forest containing only the tree edges found by the DFS algorithm.
+ */
+Graph Algorithms::dfs(const Graph& g, int start, AlgorithmObserver* observer) {
+    TraversalResult result;
+    dfs(g, start, result, observer);
+    return result.toGraph();
+}
+
+/**
+ * @brief DFS on the CSR form of a graph, same result as dfs on the original Graph.
+ */
+Graph Algorithms::dfs(const CSRGraph& g, int start, AlgorithmObserver* observer) {
+    TraversalResult result;
+    dfs(g, start, result, observer);
+    return result.toGraph();
+}
+
+/**
+ * @brief DFS writing the forest parents, depths and visit order into result.
+ * @param g The input graph.
+ * @param start The starting vertex for the DFS.
+ * @param result Output, reset to the number of vertices of g.
+ * @param observer Optional hooks called while the search runs.
+ */
+void Algorithms::dfs(const Graph& g, int start, TraversalResult& result, AlgorithmObserver* observer) {
+    withObserver(observer, [&](auto& obs) { dfsSearch(ListView(g), start, result, obs); });
+}
+
+void Algorithms::dfs(const CSRGraph& g, int start, TraversalResult& result, AlgorithmObserver* observer) {
+    withObserver(observer, [&](auto& obs) { dfsSearch(CSRView(g), start, result, obs); });
+}
+
+/**
+ * @brief A helper function for DFS traversal, iterative with an explicit stack.
+ * @param g The input graph.
+ * @param tree The tree being built.
+ * @param u The current vertex being visited.
+ * @param color Array indicating the visit status of each vertex.
+ * @param index The current index for visit order tracking.
+ */
+void Algorithms::dfs_visit(const Graph& g, Graph& tree, int u, colors* color, int& index) {
+    // Check if vertex index is valid
+    if (u < 0 || u >= g.getNumVertices()) {
+        throw std::out_of_range("Invalid vertex index: " + std::to_string(u));
+    }
+    DfsFrame<ListView>* stack = new DfsFrame<ListView>[g.getNumVertices()];
+    DfsTreeSink sink{tree, index};
+    dfsVisit(ListView(g), u, color, stack, sink);
+    delete[] stack;
+}
+
+/**
+ * @brief Finds the shortest paths from a source vertex to all other vertices using Dijkstra's algorithm.
+ * @param g The input graph.
+ * @param start The source vertex.
+ * @param observer Optional hooks called while the search runs.
+ * @return A shortest path tree representing the minimum distances from the source to each reachable vertex.
+ * The visit order of the tree is the order in which vertices were settled.
+ * @throws std::invalid_argument If the graph contains negative weight edges.
+ */
+Graph Algorithms::dijkstra(const Graph& g, int start, AlgorithmObserver* observer) {
+    TraversalResult result;
+    dijkstra(g, start, result, observer);
+    return result.toGraph();
+}
+
+/**
+ * @brief Dijkstra on the CSR form of a graph, same result as dijkstra on the original Graph.
+ */
+Graph Algorithms::dijkstra(const CSRGraph& g, int start, AlgorithmObserver* observer) {
+    TraversalResult result;
+    dijkstra(g, start, result, observer);
+    return result.toGraph();
+}
+
+/**
+ * @brief Dijkstra writing shortest path parents, distances and settle order into result.
+ * @param g The input graph.
+ * @param start The source vertex.
+ * @param result Output, reset to the number of vertices of g.
+ * @param observer Optional hooks called while the search runs.
+ * @throws std::invalid_argument If the graph contains negative weight edges.
+ */
+void Algorithms::dijkstra(const Graph& g, int start, TraversalResult& result, AlgorithmObserver* observer) {
+    withObserver(observer, [&](auto& obs) { dijkstraSearch(ListView(g), start, DijkstraLimits(), result, obs); });
+}
+
+void Algorithms::dijkstra(const CSRGraph& g, int start, TraversalResult& result, AlgorithmObserver* observer) {
+    withObserver(observer, [&](auto& obs) { dijkstraSearch(CSRView(g), start, DijkstraLimits(), result, obs); });
+}
+
+
+/**
+ * @brief Dijkstra that stops as soon as the limits are met.
+ * With targets the search ends once all of them are settled, with maxDistance
+ * it ends before settling any vertex farther than that (a radius query). Only
+ * settled vertices appear in the result, every other vertex is unreached.
+ * @param g The input graph.
+ * @param start The source vertex.
+ * @param limits Targets and/or distance bound, see DijkstraLimits.
+ * @param observer Optional hooks called while the search runs.
+ * @return The shortest path tree of the settled vertices.
+ * @throws std::out_of_range If start or a target is not a vertex of g.
+ * @throws std::invalid_argument If the search meets a negative weight edge.
+ */
+Graph Algorithms::dijkstra(const Graph& g, int start, const DijkstraLimits& limits, AlgorithmObserver* observer) {
+    TraversalResult result;
+    dijkstra(g, start, limits, result, observer);
+    return result.toGraph();
+}
+
+Graph Algorithms::dijkstra(const CSRGraph& g, int start, const DijkstraLimits& limits, AlgorithmObserver* observer) {
+    TraversalResult result;
+    dijkstra(g, start, limits, result, observer);
+    return result.toGraph();
+}
+
+void Algorithms::dijkstra(const Graph& g, int start, const DijkstraLimits& limits, TraversalResult& result,
+                          AlgorithmObserver* observer) {
+    withObserver(observer, [&](auto& obs) { dijkstraSearch(ListView(g), start, limits, result, obs); });
+}
+
+void Algorithms::dijkstra(const CSRGraph& g, int start, const DijkstraLimits& limits, TraversalResult& result,
+                          AlgorithmObserver* observer) {
+    withObserver(observer, [&](auto& obs) { dijkstraSearch(CSRView(g), start, limits, result, obs); });
+}
+
+/**
+ * @brief Finds a Minimum Spanning Tree (MST) using Prim's algorithm.
+ * @param g The input graph.
+ * @param observer Optional hooks called while the algorithm runs.
+ * @return The MST of the graph.
+ */
+Graph Algorithms::prim(const Graph& g, AlgorithmObserver* observer) {
+    TraversalResult result;
+    prim(g, result, observer);
+    return result.toGraph();
+}
+
+/**
+ * @brief Prim on the CSR form of a graph, same result as prim on the original Graph.
+ */
+Graph Algorithms::prim(const CSRGraph& g, AlgorithmObserver* observer) {
+    TraversalResult result;
+    prim(g, result, observer);
+    return result.toGraph();
+}
+
+/**
+ * @brief Prim writing MST parents, keys and the order vertices joined the tree into result.
+ * @param g The input graph.
+ * @param result Output, reset to the number of vertices of g.
+ * @param observer Optional hooks called while the algorithm runs.
+ */
+void Algorithms::prim(const Graph& g, TraversalResult& result, AlgorithmObserver* observer) {
+    withObserver(observer, [&](auto& obs) { primSearch(ListView(g), result, obs); });
+}
+
+void Algorithms::prim(const CSRGraph& g, TraversalResult& result, AlgorithmObserver* observer) {
+    withObserver(observer, [&](auto& obs) { primSearch(CSRView(g), result, obs); });
+}
+
+/**
+ * @brief Finds a Minimum Spanning Tree (MST) using Kruskal's algorithm.
+ * @param g The input graph.
+ * @param observer Optional hooks called while the algorithm runs.
+ * @return The MST of the graph.
+ */
+Graph Algorithms::kruskal(const Graph& g, AlgorithmObserver* observer) {
+    return kruskal(g, ComparisonSort, observer);
+}
+
+/**
+ * @brief Kruskal on the CSR form of a graph, same result as kruskal on the original Graph.
+ */
+Graph Algorithms::kruskal(const CSRGraph& g, AlgorithmObserver* observer) {
+    return kruskal(g, ComparisonSort, observer);
+}
+
+/**
+ * @brief Kruskal writing the MST forest into result.
+ * Each tree is rooted at its first vertex in order (the order in which
+ * accepted edges first touched the vertices).
+ * @param g The input graph.
+ * @param result Output, reset to the number of vertices of g.
+ * @param observer Optional hooks called while the algorithm runs.
+ */
+void Algorithms::kruskal(const Graph& g, TraversalResult& result, AlgorithmObserver* observer) {
+    kruskal(g, ComparisonSort, result, observer);
+}
+
+void Algorithms::kruskal(const CSRGraph& g, TraversalResult& result, AlgorithmObserver* observer) {
+    kruskal(g, ComparisonSort, result, observer);
+}
+
+/**
+ * @brief Kruskal with a selectable edge sort.
+ * Both sorts are stable, so every mode returns exactly the same tree.
+ * @param g The input graph.
+ * @param mode ComparisonSort (merge sort, O(E log E)) or RadixSort (LSD radix on the int weights, O(E)).
+ * @param observer Optional hooks called while the algorithm runs.
+ * @return The MST of the graph.
+ */
+Graph Algorithms::kruskal(const Graph& g, KruskalSort mode, AlgorithmObserver* observer) {
+    TraversalResult result;
+    kruskal(g, mode, result, observer);
+    return result.toGraph();
+}
+
+Graph Algorithms::kruskal(const CSRGraph& g, KruskalSort mode, AlgorithmObserver* observer) {
+    TraversalResult result;
+    kruskal(g, mode, result, observer);
+    return result.toGraph();
+}
+
+void Algorithms::kruskal(const Graph& g, KruskalSort mode, TraversalResult& result, AlgorithmObserver* observer) {
+    withObserver(observer, [&](auto& obs) { kruskalSearch(ListView(g), mode, result, obs); });
+}
+
+void Algorithms::kruskal(const CSRGraph& g, KruskalSort mode, TraversalResult& result, AlgorithmObserver* observer) {
+    withObserver(observer, [&](auto& obs) { kruskalSearch(CSRView(g), mode, result, obs); });
+}
+
+/**
+ * @brief Finds a Minimum Spanning Tree (MST) with Filter-Kruskal.
+ * Edges are partitioned around a pivot weight like quicksort. The light side is
+ * solved first, then heavy edges already inside one component are filtered out
+ * before they are ever sorted. Same tree weight as kruskal, much less sorting
+ * on dense graphs.
+ * @param g The input graph.
+ * @param observer Optional hooks called while the algorithm runs.
+ * @return The MST of the graph.
+ */
+Graph Algorithms::filterKruskal(const Graph& g, AlgorithmObserver* observer) {
+    TraversalResult result;
+    filterKruskal(g, result, observer);
+    return result.toGraph();
+}
+
+Graph Algorithms::filterKruskal(const CSRGraph& g, AlgorithmObserver* observer) {
+    TraversalResult result;
+    filterKruskal(g, result, observer);
+    return result.toGraph();
+}
+
+void Algorithms::filterKruskal(const Graph& g, TraversalResult& result, AlgorithmObserver* observer) {
+    withObserver(observer, [&](auto& obs) { filterKruskalSearch(ListView(g), result, obs); });
+}
+
+void Algorithms::filterKruskal(const CSRGraph& g, TraversalResult& result, AlgorithmObserver* observer) {
+    withObserver(observer, [&](auto& obs) { filterKruskalSearch(CSRView(g), result, obs); });
+}
+
+/**
+ * @brief Finds a Minimum Spanning Tree (MST) with parallel Boruvka.
+ * Every round finds the lightest outgoing edge of each component in parallel
+ * across the edges and merges the components along them in a shared
+ * ConcurrentUnionFind.
+ * Same tree weight as kruskal (the tree itself can differ when weights tie).
+ * @param g The input graph.
+ * @param numThreads Number of worker threads, 0 for the hardware concurrency.
+ * @param observer Optional hooks, called on one thread after the last round.
+ * @return The MST (or minimum spanning forest) of the graph.
+ */
+Graph Algorithms::boruvka(const Graph& g, int numThreads, AlgorithmObserver* observer) {
+    TraversalResult result;
+    boruvka(g, numThreads, result, observer);
+    return result.toGraph();
+}
+
+Graph Algorithms::boruvka(const CSRGraph& g, int numThreads, AlgorithmObserver* observer) {
+    TraversalResult result;
+    boruvka(g, numThreads, result, observer);
+    return result.toGraph();
+}
+
+void Algorithms::boruvka(const Graph& g, int numThreads, TraversalResult& result, AlgorithmObserver* observer) {
+    withObserver(observer, [&](auto& obs) { boruvkaSearch(ListView(g), numThreads, result, obs); });
+}
+
+void Algorithms::boruvka(const CSRGraph& g, int numThreads, TraversalResult& result, AlgorithmObserver* observer) {
+    withObserver(observer, [&](auto& obs) { boruvkaSearch(CSRView(g), numThreads, result, obs); });
+}
+
+/**
+ * @brief Hop distances from many sources at once.
+ * The sources run in batches of 64 that traverse the graph together, each
+ * vertex carrying one bit per source of the batch, so a batch costs about
+ * as much as a single bfs.
+ * @param g The input graph.
+ * @param sources The source vertices, repeats are allowed.
+ * @param numSources Number of sources.
+ * @param distances Output of numSources * getNumVertices() entries,
+ * distances[i * n + v] is the hop distance from sources[i] to v, -1 if unreachable.
+ * @throws std::out_of_range If a source is not a vertex of g.
+ */
+void Algorithms::multiSourceBfs(const Graph& g, const int* sources, int numSources, int* distances) {
+    multiSourceBfsSearch(ListView(g), sources, numSources, distances);
+}
+
+void Algorithms::multiSourceBfs(const CSRGraph& g, const int* sources, int numSources, int* distances) {
+    multiSourceBfsSearch(CSRView(g), sources, numSources, distances);
+}
+
+/**
+ * @brief Multi-threaded level-synchronous BFS.
+ * Every level's frontier is split across the threads, unvisited neighbors are
+ * claimed with an atomic compare-and-swap and collected in per-thread buffers
+ * that are merged without locks. Distances are the same as bfs; parents and
+ * the order within a level may differ between runs.
+ * The observer is called on one thread after the search, level by level.
+ * @param g The input graph.
+ * @param start The starting vertex for the BFS.
+ * @param numThreads Number of worker threads, 0 for the hardware concurrency.
+ * @param observer Optional hooks.
+ * @return A BFS tree.
+ */
+Graph Algorithms::parallelBfs(const Graph& g, int start, int numThreads, AlgorithmObserver* observer) {
+    TraversalResult result;
+    parallelBfs(g, start, numThreads, result, observer);
+    return result.toGraph();
+}
+
+Graph Algorithms::parallelBfs(const CSRGraph& g, int start, int numThreads, AlgorithmObserver* observer) {
+    TraversalResult result;
+    parallelBfs(g, start, numThreads, result, observer);
+    return result.toGraph();
+}
+
+void Algorithms::parallelBfs(const Graph& g, int start, int numThreads, TraversalResult& result, AlgorithmObserver* observer) {
+    withObserver(observer, [&](auto& obs) { parallelBfsSearch(ListView(g), start, numThreads, result, obs); });
+}
+
+void Algorithms::parallelBfs(const CSRGraph& g, int start, int numThreads, TraversalResult& result, AlgorithmObserver* observer) {
+    withObserver(observer, [&](auto& obs) { parallelBfsSearch(CSRView(g), start, numThreads, result, obs); });
+}
+
+/**
+ * @brief Shortest path between two vertices by bidirectional Dijkstra.
+ * Searches forward from source and backward from target in turns and stops as
+ * soon as the two frontiers prove the best meeting path optimal, which usually
+ * settles a small part of the vertices dijkstra would.
+ * @param g The input graph.
+ * @param source The first vertex of the path.
+ * @param target The last vertex of the path.
+ * @param result Output: distance, path from source to target and settled count.
+ * @throws std::out_of_range If source or target is not a vertex of g.
+ * @throws std::invalid_argument If the search meets a negative weight edge.
+ */
+void Algorithms::bidirectionalDijkstra(const Graph& g, int source, int target, PathResult& result) {
+    bidirectionalSearch(ListView(g), source, target, result);
+}
+
+void Algorithms::bidirectionalDijkstra(const CSRGraph& g, int source, int target, PathResult& result) {
+    bidirectionalSearch(CSRView(g), source, target, result);
+}
+
+/**
+ * @brief A* with the straight-line distance to target as the heuristic.
+ * The result is exact when every edge weighs at least the straight-line
+ * distance between its endpoints.
+ * @param g The input graph.
+ * @param source The first vertex of the path.
+ * @param target The last vertex of the path.
+ * @param coordinates Coordinates of every vertex of g.
+ * @param result Output: distance, path from source to target and settled count.
+ * @throws std::invalid_argument If coordinates does not cover the vertices of g.
+ */
+void Algorithms::aStar(const Graph& g, int source, int target, const CoordinateTable& coordinates, PathResult& result) {
+    if (coordinates.getNumVertices() != g.getNumVertices()) {
+        throw std::invalid_argument("Coordinate table does not match the graph");
+    }
+    if (target < 0 || target >= g.getNumVertices()) {
+        throw std::out_of_range("Vertex " + std::to_string(target) + " is out of bounds");
+    }
+    aStar(g, source, target, EuclideanHeuristic(coordinates, target), result);
+}
+
+void Algorithms::aStar(const CSRGraph& g, int source, int target, const CoordinateTable& coordinates, PathResult& result) {
+    if (coordinates.getNumVertices() != g.getNumVertices()) {
+        throw std::invalid_argument("Coordinate table does not match the graph");
+    }
+    if (target < 0 || target >= g.getNumVertices()) {
+        throw std::out_of_range("Vertex " + std::to_string(target) + " is out of bounds");
+    }
+    aStar(g, source, target, EuclideanHeuristic(coordinates, target), result);
+}
+
+/**
+ * @brief ALT query: A* with landmark lower bounds as the heuristic.
+ * The bounds come from the triangle inequality, so the result is always exact.
+ * @param g The input graph.
+ * @param source The first vertex of the path.
+ * @param target The last vertex of the path.
+ * @param landmarks A landmark table built for g.
+ * @param result Output: distance, path from source to target and settled count.
+ * @throws std::invalid_argument If the table does not match g: a different size, entry
+ *         count or edge checksum, as for a table built before g was edited.
+ */
+void Algorithms::aStar(const Graph& g, int source, int target, const LandmarkTable& landmarks, PathResult& result) {
+    if (!landmarks.matches(g)) {
+        throw std::invalid_argument("Landmark table does not match the graph");
+    }
+    if (target < 0 || target >= g.getNumVertices()) {
+        throw std::out_of_range("Vertex " + std::to_string(target) + " is out of bounds");
+    }
+    aStar(g, source, target, LandmarkHeuristic(landmarks, target), result);
+}
+
+void Algorithms::aStar(const CSRGraph& g, int source, int target, const LandmarkTable& landmarks, PathResult& result) {
+    if (!landmarks.matches(g)) {
+        throw std::invalid_argument("Landmark table does not match the graph");
+    }
+    if (target < 0 || target >= g.getNumVertices()) {
+        throw std::out_of_range("Vertex " + std::to_string(target) + " is out of bounds");
+    }
+    aStar(g, source, target, LandmarkHeuristic(landmarks, target), result);
+}
+
+/**
+ * @brief Parallel single-source shortest paths by delta-stepping.
+ * Tentative distances are kept in buckets of width delta. Each bucket relaxes
+ * its light edges (weight <= delta) in parallel until it stays empty, then its
+ * heavy edges, with every relaxation an atomic min on the vertex's distance
+ * and parent. Distances equal dijkstra's and the parents form a valid
+ * shortest-path tree, though where a vertex has several shortest-path
+ * predecessors the chosen one may differ between runs. order lists the
+ * vertices bucket by bucket.
+ * The observer is called on one thread after the search (no edgeRelaxed events).
+ * @param g The input graph.
+ * @param start The source vertex.
+ * @param delta Bucket width, 0 for the largest weight divided by the average
+ * degree. Small values mean little wasted work per bucket but many buckets
+ * (and maxWeight / delta buckets of bookkeeping per thread).
+ * @param numThreads Number of worker threads, 0 for the hardware concurrency.
+ * @param observer Optional hooks.
+ * @return A shortest path tree.
+ * @throws std::invalid_argument If the graph contains negative weight edges.
+ */
+Graph Algorithms::deltaStepping(const Graph& g, int start, int delta, int numThreads, AlgorithmObserver* observer) {
+    TraversalResult result;
+    deltaStepping(g, start, delta, numThreads, result, observer);
+    return result.toGraph();
+}
+
+Graph Algorithms::deltaStepping(const CSRGraph& g, int start, int delta, int numThreads, AlgorithmObserver* observer) {
+    TraversalResult result;
+    deltaStepping(g, start, delta, numThreads, result, observer);
+    return result.toGraph();
+}
+
+void Algorithms::deltaStepping(const Graph& g, int start, int delta, int numThreads, TraversalResult& result,
+                               AlgorithmObserver* observer) {
+    withObserver(observer, [&](auto& obs) { deltaSteppingSearch(ListView(g), start, delta, numThreads, result, obs); });
+}
+
+void Algorithms::deltaStepping(const CSRGraph& g, int start, int delta, int numThreads, TraversalResult& result,
+                               AlgorithmObserver* observer) {
+    withObserver(observer, [&](auto& obs) { deltaSteppingSearch(CSRView(g), start, delta, numThreads, result, obs); });
+}
+
+/**
+ * @brief Labels the connected components of a graph in parallel.
+ * @param g The input graph.
+ * @param label Output array of getNumVertices() entries, label[v] is the component
+ * id of v. Ids are 0, 1, ... in order of the smallest vertex of each component.
+ * @param numThreads Number of worker threads, 0 for the hardware concurrency.
+ * @return The number of connected components.
+ */
+int Algorithms::connectedComponents(const Graph& g, int* label, int numThreads) {
+    return componentsSearch(ListView(g), label, numThreads);
+}
+
+int Algorithms::connectedComponents(const CSRGraph& g, int* label, int numThreads) {
+    return componentsSearch(CSRView(g), label, numThreads);
+}
+
+/**
+ * @brief Offline dynamic connectivity over an edge timeline.
+ * Starting from the edges of graph, the events are applied in order: InsertEdge
+ * and DeleteEdge change the edge set, ConnectedQuery asks whether u and v are
+ * connected at that point. All queries are answered together by divide and
+ * conquer over time with a RollbackUnionFind, O((V + E) log Q log V).
+ * @param g The graph at the start of the timeline, it is not modified.
+ * @param events The timeline.
+ * @param numEvents Number of events.
+ * @param answers Output, answers[k] is the answer to the k-th ConnectedQuery.
+ * Needs room for one entry per query.
+ * @return The number of queries.
+ * @throws std::out_of_range If an event names an invalid vertex.
+ * @throws std::invalid_argument If an insert adds an existing edge or a self-loop,
+ * or a delete removes a missing edge.
+ */
+int Algorithms::dynamicConnectivity(const Graph& g, const ConnectivityEvent* events, int numEvents, bool* answers) {
+    if (numEvents < 0) {
+        throw std::invalid_argument("Number of events must be non-negative");
+    }
+    ConnectivityTimeline timeline(g, events, numEvents);
+    timeline.replay(g, events, numEvents);
+    timeline.build();
+
+    int numQueries = timeline.queryCount();
+    if (numQueries > 0) {
+        RollbackUnionFind uf(g.getNumVertices());
+        timeline.answer(0, 0, numQueries, uf, answers);
+    }
+    return numQueries;
+}
+
+/**
+ * @brief Stable sort of an edge array by weight, the sort phase of Kruskal.
+ * @param edges The edges to sort in place.
+ * @param count Number of edges.
+ * @param mode ComparisonSort or RadixSort.
+ */
+void Algorithms::sortEdgesByWeight(Edge* edges, int count, KruskalSort mode) {
+    if (mode == RadixSort)
+        radixSortByWeight(edges, count);
+    else
+        mergeSortByWeight(edges, count);
+}
+
+
+// ============ Print Observer =======
+// Writes one line per event, for debugging runs on small graphs
+
+void PrintObserver::edgeRelaxed(int u, int v, int weight) {
+    out << "Relaxed edge: " << u << " - " << v << " weight: " << weight << '\n';
+}
+
+void PrintObserver::vertexSettled(int v) {
+    out << "Settled vertex: " << v << '\n';
+}
+
+void PrintObserver::treeEdgeAdded(int u, int v, int weight) {
+    out << "Added edge: " << u << " - " << v << " weight: " << weight << '\n';
+}
+
+}
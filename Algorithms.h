@@ -3,7 +3,11 @@
 #define ALGORITHMS_H
 
 #include "Graph.h"
+#include "CSRGraph.h"
 #include "DataStructures.h"
+#include "GraphView.h"
+#include "Landmarks.h"
+#include <cmath>
 #define INT_MAX 2147483647
 
 namespace graph {
@@ -14,17 +18,440 @@ namespace graph {
         Black
     };
 
+    // Edge sort used by Kruskal
+    enum KruskalSort {
+        ComparisonSort, // Stable merge sort, O(E log E)
+        RadixSort       // Stable LSD radix sort on the int weights, O(E)
+    };
+
+    // Level expansion used by bfs
+    enum BfsMode {
+        TopDown,            // Frontier vertices scan their neighbors
+        DirectionOptimizing // Switches to bottom-up levels (unvisited vertices look for a
+                            // frontier neighbor) while the frontier is large
+    };
+
+    // Kind of entry in an edge timeline for dynamicConnectivity
+    enum ConnectivityEventType {
+        InsertEdge,    // Add the edge u - v
+        DeleteEdge,    // Remove the edge u - v
+        ConnectedQuery // Ask whether u and v are connected at this point
+    };
+
+    struct ConnectivityEvent {
+        ConnectivityEventType type;
+        int u;
+        int v;
+    };
+
+// Working state of the shortest path searches, kept inside their result so that
+// repeated queries skip the O(vertices) setup. Between queries every label is
+// clear (distance INT_MAX, parent -1, flag false) and the queues are empty: a
+// query records each vertex it labels with touch(), and finish() clears only
+// those. Flags are cleared by the query that set them.
+// prepare() costs O(vertices) only when the size changes, or when the previous
+// query ended in an exception before reaching finish().
+class SearchScratch {
+public:
+    int* distance[2]; // Per search direction, sides of them allocated
+    int* parent[2];
+    PriorityQueue* queue[2]; // One per direction, at least one
+    bool* flag;
+
+    SearchScratch();
+    SearchScratch(const SearchScratch&) = delete;
+    SearchScratch& operator=(const SearchScratch&) = delete;
+    ~SearchScratch();
+
+    // Start a query on vertices vertices using labels for sides directions,
+    // 0 for a search that keeps its labels in a TraversalResult
+    void prepare(int vertices, int sides);
+    // Record that v got a label in one direction, at most once per direction
+    void touch(int v) { touched[touchedCount++] = v; }
+    // End the query: clear the touched labels and empty the queues
+    void finish();
+
+private:
+    int numVertices;
+    int sides;
+    int queues;
+    int* touched; // Up to one entry per vertex and direction
+    int touchedCount;
+    bool active; // Between prepare and finish
+
+    void clearAll();
+    void release();
+};
+
+// Compact result of a traversal or tree algorithm, filled by the
+// result overloads of Algorithms instead of building a whole Graph.
+// For every vertex v:
+//   parent[v]   - tree parent, -1 for roots and unreached vertices
+//   weight[v]   - weight of the tree edge parent[v] - v (for bfs the hop distance,
+//                 as in the bfs tree)
+//   distance[v] - hop count (bfs), depth (dfs, kruskal), path length (dijkstra)
+//                 or key (prim); -1 (bfs, dfs, kruskal) or INT_MAX (dijkstra, prim)
+//                 when unreached
+// order holds the visited vertices in visit order, orderCount of them.
+// A result can be reused across queries, the arrays are only reallocated
+// when the number of vertices changes. dijkstra clears them in O(orderCount)
+// when the previous query was also a dijkstra, and keeps its queue in the result.
+class TraversalResult {
+public:
+    int numVertices;
+    int* parent;
+    int* weight;
+    int* distance;
+    int* order;
+    int orderCount;
+
+    TraversalResult();
+    explicit TraversalResult(int vertices);
+    TraversalResult(const TraversalResult& other); // Deep copy constructor
+    TraversalResult& operator=(const TraversalResult& other); // Assignment operator
+    TraversalResult(TraversalResult&& other) noexcept;
+    TraversalResult& operator=(TraversalResult&& other) noexcept;
+    ~TraversalResult();
+
+    // Resize for vertices and clear: no parents, zero weights, every distance set to unreached
+    void reset(int vertices, int unreached);
+    // Same as reset, but in O(orderCount) when the last search on this result
+    // called markSparse with the same size and unreached value and the arrays
+    // were not written since
+    void resetSparse(int vertices, int unreached);
+    // Declare that every vertex outside order is cleared to unreached
+    void markSparse(int unreached);
+
+    // Search state reused by the next query, created on first use. Copies start without one.
+    SearchScratch& scratch();
+
+    // Build the equivalent tree Graph: one edge parent[v] - v per vertex with a parent,
+    // added in visit order, and visitOrder copied from order
+    Graph toGraph() const;
+
+private:
+    bool sparse; // Set by markSparse, until the next reset
+    int sparseUnreached;
+    SearchScratch* searchScratch;
+
+    void allocate(int vertices);
+    void release();
+    void copyFrom(const TraversalResult& other);
+};
+
+// Stopping rules for dijkstra: the search ends once every one of the numTargets
+// targets is settled (no target rule when numTargets is 0), or before settling
+// a vertex farther than maxDistance
+struct DijkstraLimits {
+    const int* targets = nullptr;
+    int numTargets = 0;
+    int maxDistance = INT_MAX;
+};
+
+// Result of a point-to-point shortest path query:
+//   distance   - length of the shortest path, INT_MAX if target is unreachable
+//   path       - its vertices from source to target, pathLength of them
+//                (0 when target is unreachable)
+//   settled    - vertices the search settled, a measure of how much it explored
+// Like TraversalResult, a result can be reused across queries, and then keeps
+// the search state so a query costs only what it explores.
+class PathResult {
+public:
+    int distance;
+    int* path;
+    int pathLength;
+    int settled;
+
+    PathResult();
+    PathResult(const PathResult& other);
+    PathResult& operator=(const PathResult& other);
+    PathResult(PathResult&& other) noexcept;
+    PathResult& operator=(PathResult&& other) noexcept;
+    ~PathResult();
+
+    // Make room for a path through up to vertices vertices and clear: unreachable, empty path
+    void reset(int vertices);
+
+    // Search state reused by the next query, created on first use. Copies start without one.
+    SearchScratch& scratch();
+
+private:
+    int capacity;
+    SearchScratch* searchScratch;
+
+    void release();
+    void copyFrom(const PathResult& other);
+};
+
+// Planar coordinates of every vertex, kept next to a graph for goal-directed
+// search (see EuclideanHeuristic). New tables start with every vertex at (0, 0).
+class CoordinateTable {
+public:
+    explicit CoordinateTable(int vertices);
+    CoordinateTable(const CoordinateTable& other);
+    CoordinateTable& operator=(const CoordinateTable& other);
+    CoordinateTable(CoordinateTable&& other) noexcept;
+    CoordinateTable& operator=(CoordinateTable&& other) noexcept;
+    ~CoordinateTable();
+
+    void set(int v, double x, double y);
+    double getX(int v) const { return xs[v]; }
+    double getY(int v) const { return ys[v]; }
+    int getNumVertices() const { return numVertices; }
+
+private:
+    int numVertices;
+    double* xs;
+    double* ys;
+
+    void copyFrom(const CoordinateTable& other);
+};
+
+// A* heuristic: scale times the straight-line distance from v to target, rounded
+// down. It never overestimates (is admissible) as long as every edge weighs at
+// least scale times the straight-line distance between its endpoints.
+struct EuclideanHeuristic {
+    const CoordinateTable& coordinates;
+    int target;
+    double scale;
+
+    EuclideanHeuristic(const CoordinateTable& table, int goal, double factor = 1.0)
+        : coordinates(table), target(goal), scale(factor) {}
+
+    int operator()(int v) const {
+        double dx = coordinates.getX(v) - coordinates.getX(target);
+        double dy = coordinates.getY(v) - coordinates.getY(target);
+        return static_cast<int>(scale * std::sqrt(dx * dx + dy * dy));
+    }
+};
+
+// Hooks for watching an algorithm run, e.g. for debugging or tracing.
+// Every hook does nothing by default, override the ones you need and pass
+// the observer to an algorithm. Without an observer the algorithms are
+// compiled with empty inline hooks, so unobserved runs pay nothing.
+//   edgeRelaxed   - a tentative distance (dijkstra) or key (prim) improved via u - v
+//   vertexSettled - v is final: dequeued (bfs), discovered (dfs), extracted from
+//                   the queue (dijkstra, prim) or first touched by the MST (kruskal)
+//   treeEdgeAdded - u - v became an edge of the resulting tree, weight is the graph edge weight
+class AlgorithmObserver {
+public:
+    virtual ~AlgorithmObserver() {}
+    virtual void edgeRelaxed(int u, int v, int weight) { (void)u; (void)v; (void)weight; }
+    virtual void vertexSettled(int v) { (void)v; }
+    virtual void treeEdgeAdded(int u, int v, int weight) { (void)u; (void)v; (void)weight; }
+};
+
+// Observer that prints every event to a stream
+class PrintObserver : public AlgorithmObserver {
+private:
+    std::ostream& out;
+
+public:
+    explicit PrintObserver(std::ostream& stream = std::cout) : out(stream) {}
+    void edgeRelaxed(int u, int v, int weight) override;
+    void vertexSettled(int v) override;
+    void treeEdgeAdded(int u, int v, int weight) override;
+};
+
 class Algorithms {
 public:
-    static Graph bfs(const Graph& graph, int start);
-    static Graph dfs(const Graph& graph, int start);
+    static Graph bfs(const Graph& graph, int start, AlgorithmObserver* observer = nullptr);
+    static Graph dfs(const Graph& graph, int start, AlgorithmObserver* observer = nullptr);
     static void dfs_visit(const Graph &g, Graph &tree, int u, colors *color, int &index);
     
-    static Graph dijkstra(const Graph &graph, int start);
-    static Graph prim(const Graph& graph);
-    static Graph kruskal(const Graph& graph);
+    static Graph dijkstra(const Graph &graph, int start, AlgorithmObserver* observer = nullptr);
+    static Graph prim(const Graph& graph, AlgorithmObserver* observer = nullptr);
+    static Graph kruskal(const Graph& graph, AlgorithmObserver* observer = nullptr);
+
+    // Same algorithms on the frozen CSR representation
+    static Graph bfs(const CSRGraph& graph, int start, AlgorithmObserver* observer = nullptr);
+    static Graph dfs(const CSRGraph& graph, int start, AlgorithmObserver* observer = nullptr);
+    static Graph dijkstra(const CSRGraph& graph, int start, AlgorithmObserver* observer = nullptr);
+    static Graph prim(const CSRGraph& graph, AlgorithmObserver* observer = nullptr);
+    static Graph kruskal(const CSRGraph& graph, AlgorithmObserver* observer = nullptr);
+
+    // Same algorithms writing a compact TraversalResult instead of a tree Graph
+    static void bfs(const Graph& graph, int start, TraversalResult& result, AlgorithmObserver* observer = nullptr);
+    static void bfs(const CSRGraph& graph, int start, TraversalResult& result, AlgorithmObserver* observer = nullptr);
+    static void dfs(const Graph& graph, int start, TraversalResult& result, AlgorithmObserver* observer = nullptr);
+    static void dfs(const CSRGraph& graph, int start, TraversalResult& result, AlgorithmObserver* observer = nullptr);
+    static void dijkstra(const Graph& graph, int start, TraversalResult& result, AlgorithmObserver* observer = nullptr);
+    static void dijkstra(const CSRGraph& graph, int start, TraversalResult& result, AlgorithmObserver* observer = nullptr);
+    static void prim(const Graph& graph, TraversalResult& result, AlgorithmObserver* observer = nullptr);
+    static void prim(const CSRGraph& graph, TraversalResult& result, AlgorithmObserver* observer = nullptr);
+    static void kruskal(const Graph& graph, TraversalResult& result, AlgorithmObserver* observer = nullptr);
+    static void kruskal(const CSRGraph& graph, TraversalResult& result, AlgorithmObserver* observer = nullptr);
+
+    // BFS with a selectable level expansion, TopDown is the default above
+    static Graph bfs(const Graph& graph, int start, BfsMode mode, AlgorithmObserver* observer = nullptr);
+    static Graph bfs(const CSRGraph& graph, int start, BfsMode mode, AlgorithmObserver* observer = nullptr);
+    static void bfs(const Graph& graph, int start, BfsMode mode, TraversalResult& result, AlgorithmObserver* observer = nullptr);
+    static void bfs(const CSRGraph& graph, int start, BfsMode mode, TraversalResult& result, AlgorithmObserver* observer = nullptr);
+
+    // Kruskal with a selectable edge sort, ComparisonSort is the default above
+    static Graph kruskal(const Graph& graph, KruskalSort mode, AlgorithmObserver* observer = nullptr);
+    static Graph kruskal(const CSRGraph& graph, KruskalSort mode, AlgorithmObserver* observer = nullptr);
+    static void kruskal(const Graph& graph, KruskalSort mode, TraversalResult& result, AlgorithmObserver* observer = nullptr);
+    static void kruskal(const CSRGraph& graph, KruskalSort mode, TraversalResult& result, AlgorithmObserver* observer = nullptr);
+    static void sortEdgesByWeight(Edge* edges, int count, KruskalSort mode);
+
+    // Filter-Kruskal MST: quicksort-style partitioning that filters heavy edges
+    // already connected instead of sorting them
+    static Graph filterKruskal(const Graph& graph, AlgorithmObserver* observer = nullptr);
+    static Graph filterKruskal(const CSRGraph& graph, AlgorithmObserver* observer = nullptr);
+    static void filterKruskal(const Graph& graph, TraversalResult& result, AlgorithmObserver* observer = nullptr);
+    static void filterKruskal(const CSRGraph& graph, TraversalResult& result, AlgorithmObserver* observer = nullptr);
+
+    // Parallel Boruvka MST, numThreads 0 uses the hardware concurrency
+    static Graph boruvka(const Graph& graph, int numThreads = 0, AlgorithmObserver* observer = nullptr);
+    static Graph boruvka(const CSRGraph& graph, int numThreads = 0, AlgorithmObserver* observer = nullptr);
+    static void boruvka(const Graph& graph, int numThreads, TraversalResult& result, AlgorithmObserver* observer = nullptr);
+    static void boruvka(const CSRGraph& graph, int numThreads, TraversalResult& result, AlgorithmObserver* observer = nullptr);
+
+    // Hop distances from every source, distances[i * n + v] for source i and vertex v
+    static void multiSourceBfs(const Graph& graph, const int* sources, int numSources, int* distances);
+    static void multiSourceBfs(const CSRGraph& graph, const int* sources, int numSources, int* distances);
+
+    // Parallel level-synchronous BFS, numThreads 0 uses the hardware concurrency
+    static Graph parallelBfs(const Graph& graph, int start, int numThreads = 0, AlgorithmObserver* observer = nullptr);
+    static Graph parallelBfs(const CSRGraph& graph, int start, int numThreads = 0, AlgorithmObserver* observer = nullptr);
+    static void parallelBfs(const Graph& graph, int start, int numThreads, TraversalResult& result, AlgorithmObserver* observer = nullptr);
+    static void parallelBfs(const CSRGraph& graph, int start, int numThreads, TraversalResult& result, AlgorithmObserver* observer = nullptr);
+
+    // Dijkstra that stops early at a set of targets and/or a distance bound
+    static Graph dijkstra(const Graph& graph, int start, const DijkstraLimits& limits, AlgorithmObserver* observer = nullptr);
+    static Graph dijkstra(const CSRGraph& graph, int start, const DijkstraLimits& limits, AlgorithmObserver* observer = nullptr);
+    static void dijkstra(const Graph& graph, int start, const DijkstraLimits& limits, TraversalResult& result, AlgorithmObserver* observer = nullptr);
+    static void dijkstra(const CSRGraph& graph, int start, const DijkstraLimits& limits, TraversalResult& result, AlgorithmObserver* observer = nullptr);
+
+    // A* point-to-point search. heuristic(v) returns a lower bound on the distance
+    // from v to target; it is a template parameter so that its calls inline
+    template <class Heuristic>
+    static void aStar(const Graph& graph, int source, int target, const Heuristic& heuristic, PathResult& result);
+    template <class Heuristic>
+    static void aStar(const CSRGraph& graph, int source, int target, const Heuristic& heuristic, PathResult& result);
+    // A* guided by straight-line distances (EuclideanHeuristic with scale 1)
+    static void aStar(const Graph& graph, int source, int target, const CoordinateTable& coordinates, PathResult& result);
+    static void aStar(const CSRGraph& graph, int source, int target, const CoordinateTable& coordinates, PathResult& result);
+    // ALT: A* guided by the landmark lower bounds of a LandmarkTable (LandmarkHeuristic)
+    static void aStar(const Graph& graph, int source, int target, const LandmarkTable& landmarks, PathResult& result);
+    static void aStar(const CSRGraph& graph, int source, int target, const LandmarkTable& landmarks, PathResult& result);
+
+    // Point-to-point shortest path, searching from source and target at the same time
+    static void bidirectionalDijkstra(const Graph& graph, int source, int target, PathResult& result);
+    static void bidirectionalDijkstra(const CSRGraph& graph, int source, int target, PathResult& result);
+
+    // Parallel delta-stepping shortest paths, delta 0 picks a bucket width from the
+    // weights, numThreads 0 uses the hardware concurrency
+    static Graph deltaStepping(const Graph& graph, int start, int delta = 0, int numThreads = 0, AlgorithmObserver* observer = nullptr);
+    static Graph deltaStepping(const CSRGraph& graph, int start, int delta = 0, int numThreads = 0, AlgorithmObserver* observer = nullptr);
+    static void deltaStepping(const Graph& graph, int start, int delta, int numThreads, TraversalResult& result, AlgorithmObserver* observer = nullptr);
+    static void deltaStepping(const CSRGraph& graph, int start, int delta, int numThreads, TraversalResult& result, AlgorithmObserver* observer = nullptr);
+
+    // Parallel connected components, returns the number of components
+    static int connectedComponents(const Graph& graph, int* label, int numThreads = 0);
+    static int connectedComponents(const CSRGraph& graph, int* label, int numThreads = 0);
+
+    // Offline dynamic connectivity: replays a timeline of edge inserts and deletes
+    // on top of graph and answers every query in it, returns the number of queries
+    static int dynamicConnectivity(const Graph& graph, const ConnectivityEvent* events, int numEvents, bool* answers);
+
+private:
+    template <class View, class Heuristic>
+    static void aStarSearch(const View& view, int source, int target, const Heuristic& heuristic, PathResult& result);
 };
 
+// ============ A* =======
+// Defined in the header so that every heuristic is compiled into the search.
+// Vertices are taken from the queue by distance from source plus heuristic, and
+// the search ends when target is taken. With a consistent heuristic (such as
+// EuclideanHeuristic) every vertex is taken at most once; an admissible but
+// inconsistent one can lower the distance of a vertex already taken, which then
+// goes back into the queue. The labels and queue are kept in result between
+// queries (see SearchScratch), so a query costs only the vertices it labels.
+
+template <class View, class Heuristic>
+void Algorithms::aStarSearch(const View& view, int source, int target, const Heuristic& heuristic, PathResult& result) {
+    int n = view.numVertices();
+    if (source < 0 || source >= n || target < 0 || target >= n) {
+        throw std::out_of_range("Vertex " + std::to_string(source < 0 || source >= n ? source : target) +
+                                " is out of bounds");
+    }
+    result.reset(n);
+
+    // Labels and queue come clear from result's scratch and are cleared on the way out
+    SearchScratch& scratch = result.scratch();
+    scratch.prepare(n, 1);
+    int* distance = scratch.distance[0];
+    int* parent = scratch.parent[0];
+    PriorityQueue& open = *scratch.queue[0];
+    distance[source] = 0;
+    scratch.touch(source);
+    open.insert(source, heuristic(source));
+
+    while (!open.isEmpty()) {
+        int u = open.extractMin();
+        ++result.settled;
+        if (u == target)
+            break;
+
+        for (typename View::Cursor c = view.first(u); view.valid(c); view.advance(c)) {
+            int v = view.target(c);
+            int weight = view.weight(c);
+            if (weight < 0) {
+                scratch.finish();
+                throw std::invalid_argument("Negative edge weight detected. A* cannot handle negative weights.");
+            }
+            if (distance[u] + weight < distance[v]) {
+                if (distance[v] == INT_MAX)
+                    scratch.touch(v);
+                distance[v] = distance[u] + weight;
+                parent[v] = u;
+                long long estimate = static_cast<long long>(distance[v]) + heuristic(v);
+                int priority = estimate < INT_MAX ? static_cast<int>(estimate) : INT_MAX;
+                if (open.contains(v))
+                    open.decreasePriority(v, priority);
+                else
+                    open.insert(v, priority);
+            }
+        }
+    }
+
+    if (distance[target] != INT_MAX) {
+        result.distance = distance[target];
+        for (int v = target; v != -1; v = parent[v]) {
+            result.path[result.pathLength++] = v;
+        }
+        for (int i = 0, j = result.pathLength - 1; i < j; ++i, --j) {
+            int temp = result.path[i];
+            result.path[i] = result.path[j];
+            result.path[j] = temp;
+        }
+    }
+    scratch.finish();
+}
+
+/**
+ * @brief A* shortest path from source to target.
+ * @param g The input graph.
+ * @param source The first vertex of the path.
+ * @param target The last vertex of the path.
+ * @param heuristic Functor with int operator()(int v) const returning a lower bound
+ * on the distance from v to target. A zero heuristic gives plain Dijkstra.
+ * @param result Output: distance, path from source to target and settled count.
+ * @throws std::out_of_range If source or target is not a vertex of g.
+ * @throws std::invalid_argument If the search meets a negative weight edge.
+ */
+template <class Heuristic>
+void Algorithms::aStar(const Graph& g, int source, int target, const Heuristic& heuristic, PathResult& result) {
+    aStarSearch(ListView(g), source, target, heuristic, result);
+}
+
+template <class Heuristic>
+void Algorithms::aStar(const CSRGraph& g, int source, int target, const Heuristic& heuristic, PathResult& result) {
+    aStarSearch(CSRView(g), source, target, heuristic, result);
+}
+
 } // namespace graph
 
 #endif
@@ -0,0 +1,289 @@
+// email:shmuel.benatar@msmail.ariel.ac.il
+// Benchmarks for the algorithms, built with `make bench`.
+// Kruskal sort phase: merge sort vs radix sort for growing edge counts,
+// to show where the O(E) radix sort overtakes the O(E log E) comparison sort,
+// then whole MST runs with each Kruskal variant and BFS with each level expansion,
+// single and multi-source, Dijkstra vs delta-stepping, and point-to-point queries.
+#include "Graph.h"
+#include "Algorithms.h"
+#include "Parallel.h"
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+
+using namespace std;
+using namespace graph;
+
+static unsigned int nextRandom(unsigned int& seed) {
+    seed = seed * 1103515245u + 12345u;
+    return seed >> 8;
+}
+
+// Average time in nanoseconds per edge of sorting a copy of input
+static double timeSort(const Edge* input, int count, KruskalSort mode) {
+    Edge* work = new Edge[count];
+    // Repeat small inputs so every measurement covers a few million edges
+    int repeats = 1 + (1 << 22) / count;
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for (int r = 0; r < repeats; ++r) {
+        for (int i = 0; i < count; ++i)
+            work[i] = input[i];
+        Algorithms::sortEdgesByWeight(work, count, mode);
+    }
+    chrono::steady_clock::time_point end = chrono::steady_clock::now();
+
+    delete[] work;
+    double ns = chrono::duration<double, nano>(end - start).count();
+    return ns / repeats / count;
+}
+
+static void benchmarkSorts(int maxWeight) {
+    cout << "Edge sort, weights in [0, " << maxWeight << ")" << endl;
+    cout << setw(10) << "edges" << setw(14) << "merge ns/e" << setw(14) << "radix ns/e" << setw(10) << "speedup" << endl;
+
+    unsigned int seed = 12345;
+    for (int count = 16; count <= (1 << 22); count *= 4) {
+        Edge* edges = new Edge[count];
+        for (int i = 0; i < count; ++i) {
+            edges[i] = Edge{i, i + 1, static_cast<int>(nextRandom(seed) % maxWeight)};
+        }
+        double merge = timeSort(edges, count, ComparisonSort);
+        double radix = timeSort(edges, count, RadixSort);
+        cout << setw(10) << count << fixed << setprecision(2) << setw(14) << merge << setw(14) << radix
+             << setw(10) << merge / radix << endl;
+        delete[] edges;
+    }
+    cout << endl;
+}
+
+// Random graph of n vertices and about n * degree / 2 edges: a path through all
+// vertices plus random extra edges, weights in [0, 1000000)
+static CSRGraph randomGraph(int n, int degree) {
+    unsigned int seed = 99;
+    int target = n * degree / 2;
+    Edge* edges = new Edge[target];
+    int count = 0;
+    for (int i = 0; i + 1 < n; ++i) {
+        edges[count++] = Edge{i, i + 1, static_cast<int>(nextRandom(seed) % 1000000)};
+    }
+    // Random extra edges with from < to; pairs already used are simply tried again
+    Graph probe(n);
+    for (int i = 0; i + 1 < n; ++i) {
+        probe.addEdge(i, i + 1);
+    }
+    while (count < target) {
+        int u = static_cast<int>(nextRandom(seed) % n);
+        int v = static_cast<int>(nextRandom(seed) % n);
+        if (u == v)
+            continue;
+        try {
+            probe.addEdge(u, v);
+        } catch (const invalid_argument&) {
+            continue;
+        }
+        edges[count++] = Edge{u, v, static_cast<int>(nextRandom(seed) % 1000000)};
+    }
+    Graph g(n, edges, count);
+    delete[] edges;
+    return CSRGraph(g);
+}
+
+// side x side grid, weights in [1, maxWeight]: a high-diameter graph with narrow BFS levels
+static CSRGraph gridGraph(int side, int maxWeight) {
+    unsigned int seed = 17;
+    Edge* edges = new Edge[2 * side * (side - 1)];
+    int count = 0;
+    for (int r = 0; r < side; ++r) {
+        for (int c = 0; c < side; ++c) {
+            int v = r * side + c;
+            if (c + 1 < side)
+                edges[count++] = Edge{v, v + 1, 1 + static_cast<int>(nextRandom(seed) % maxWeight)};
+            if (r + 1 < side)
+                edges[count++] = Edge{v, v + side, 1 + static_cast<int>(nextRandom(seed) % maxWeight)};
+        }
+    }
+    Graph g(side * side, edges, count);
+    delete[] edges;
+    return CSRGraph(g);
+}
+
+// Thread counts to measure: up to the hardware concurrency, but at least 4 so the
+// synchronization cost of the parallel algorithms shows on small machines too
+static int maxBenchThreads() {
+    int hardware = resolveThreadCount(0);
+    return hardware > 4 ? hardware : 4;
+}
+
+static void benchmarkKruskal(const CSRGraph& g) {
+    int n = g.getNumVertices();
+    int count = g.getNumEdges();
+
+    TraversalResult result;
+    const KruskalSort modes[2] = {ComparisonSort, RadixSort};
+    const char* names[2] = {"merge", "radix"};
+    for (int m = 0; m < 2; ++m) {
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        Algorithms::kruskal(g, modes[m], result);
+        chrono::steady_clock::time_point end = chrono::steady_clock::now();
+        cout << "Kruskal " << names[m] << ": V=" << n << " E=" << count << " "
+             << chrono::duration<double, milli>(end - start).count() << " ms" << endl;
+    }
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    Algorithms::filterKruskal(g, result);
+    chrono::steady_clock::time_point end = chrono::steady_clock::now();
+    cout << "Filter-Kruskal: V=" << n << " E=" << count << " "
+         << chrono::duration<double, milli>(end - start).count() << " ms" << endl;
+
+    for (int threads = 1; threads <= resolveThreadCount(0); threads *= 2) {
+        start = chrono::steady_clock::now();
+        Algorithms::boruvka(g, threads, result);
+        end = chrono::steady_clock::now();
+        cout << "Boruvka " << threads << " threads: V=" << n << " E=" << count << " "
+             << chrono::duration<double, milli>(end - start).count() << " ms" << endl;
+    }
+}
+
+// Top-down, direction-optimizing and parallel BFS from a few start vertices
+static void benchmarkBfs(const CSRGraph& g) {
+    TraversalResult result;
+    const BfsMode modes[2] = {TopDown, DirectionOptimizing};
+    const char* names[2] = {"top-down", "direction-optimizing"};
+    for (int m = 0; m < 2; ++m) {
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        for (int s = 0; s < 8; ++s) {
+            Algorithms::bfs(g, s * 1000, modes[m], result);
+        }
+        chrono::steady_clock::time_point end = chrono::steady_clock::now();
+        cout << "BFS " << names[m] << ": V=" << g.getNumVertices() << " E=" << g.getNumEdges() << " "
+             << chrono::duration<double, milli>(end - start).count() / 8 << " ms" << endl;
+    }
+    for (int threads = 1; threads <= maxBenchThreads(); threads *= 2) {
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        for (int s = 0; s < 8; ++s) {
+            Algorithms::parallelBfs(g, s * 1000, threads, result);
+        }
+        chrono::steady_clock::time_point end = chrono::steady_clock::now();
+        cout << "BFS parallel " << threads << " threads: V=" << g.getNumVertices() << " E=" << g.getNumEdges() << " "
+             << chrono::duration<double, milli>(end - start).count() / 8 << " ms" << endl;
+    }
+}
+
+// Dijkstra vs delta-stepping with the default bucket width and 1..N threads
+static void benchmarkShortestPaths(const CSRGraph& g) {
+    TraversalResult result;
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    Algorithms::dijkstra(g, 0, result);
+    chrono::steady_clock::time_point end = chrono::steady_clock::now();
+    cout << "Dijkstra: V=" << g.getNumVertices() << " E=" << g.getNumEdges() << " "
+         << chrono::duration<double, milli>(end - start).count() << " ms" << endl;
+
+    for (int threads = 1; threads <= maxBenchThreads(); threads *= 2) {
+        start = chrono::steady_clock::now();
+        Algorithms::deltaStepping(g, 0, 0, threads, result);
+        end = chrono::steady_clock::now();
+        cout << "Delta-stepping " << threads << " threads: V=" << g.getNumVertices() << " E=" << g.getNumEdges() << " "
+             << chrono::duration<double, milli>(end - start).count() << " ms" << endl;
+    }
+}
+
+// Point-to-point queries between random pairs: full Dijkstra, Dijkstra stopping
+// at the target, and bidirectional Dijkstra
+static void benchmarkPointToPoint(const CSRGraph& g) {
+    const int queries = 20;
+    int n = g.getNumVertices();
+    unsigned int seed = 7;
+    int sources[queries];
+    int targets[queries];
+    for (int i = 0; i < queries; ++i) {
+        sources[i] = static_cast<int>(nextRandom(seed) % n);
+        targets[i] = static_cast<int>(nextRandom(seed) % n);
+    }
+
+    TraversalResult all;
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for (int i = 0; i < queries; ++i) {
+        Algorithms::dijkstra(g, sources[i], all);
+    }
+    chrono::steady_clock::time_point end = chrono::steady_clock::now();
+    cout << "Point-to-point Dijkstra: " << chrono::duration<double, milli>(end - start).count() / queries
+         << " ms/query, " << n << " settled" << endl;
+
+    DijkstraLimits limits;
+    limits.numTargets = 1;
+    long long settled = 0;
+    start = chrono::steady_clock::now();
+    for (int i = 0; i < queries; ++i) {
+        limits.targets = &targets[i];
+        Algorithms::dijkstra(g, sources[i], limits, all);
+        settled += all.orderCount;
+    }
+    end = chrono::steady_clock::now();
+    cout << "Point-to-point Dijkstra with target: " << chrono::duration<double, milli>(end - start).count() / queries
+         << " ms/query, " << settled / queries << " settled" << endl;
+
+    PathResult path;
+    settled = 0;
+    start = chrono::steady_clock::now();
+    for (int i = 0; i < queries; ++i) {
+        Algorithms::bidirectionalDijkstra(g, sources[i], targets[i], path);
+        settled += path.settled;
+    }
+    end = chrono::steady_clock::now();
+    cout << "Point-to-point bidirectional: " << chrono::duration<double, milli>(end - start).count() / queries
+         << " ms/query, " << settled / queries << " settled" << endl;
+
+    start = chrono::steady_clock::now();
+    LandmarkTable table(g, 16);
+    end = chrono::steady_clock::now();
+    cout << "Landmark preprocessing (16): " << chrono::duration<double, milli>(end - start).count() << " ms" << endl;
+    settled = 0;
+    start = chrono::steady_clock::now();
+    for (int i = 0; i < queries; ++i) {
+        Algorithms::aStar(g, sources[i], targets[i], table, path);
+        settled += path.settled;
+    }
+    end = chrono::steady_clock::now();
+    cout << "Point-to-point ALT: " << chrono::duration<double, milli>(end - start).count() / queries
+         << " ms/query, " << settled / queries << " settled" << endl;
+}
+
+// 64 single-source BFS runs vs one bit-parallel multi-source batch
+static void benchmarkMultiSourceBfs(const CSRGraph& g) {
+    int n = g.getNumVertices();
+    int sources[64];
+    for (int i = 0; i < 64; ++i) {
+        sources[i] = i * (n / 64);
+    }
+    TraversalResult result;
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for (int i = 0; i < 64; ++i) {
+        Algorithms::bfs(g, sources[i], result);
+    }
+    chrono::steady_clock::time_point end = chrono::steady_clock::now();
+    cout << "64 BFS runs: V=" << n << " E=" << g.getNumEdges() << " "
+         << chrono::duration<double, milli>(end - start).count() << " ms" << endl;
+
+    int* distances = new int[64LL * n];
+    start = chrono::steady_clock::now();
+    Algorithms::multiSourceBfs(g, sources, 64, distances);
+    end = chrono::steady_clock::now();
+    cout << "Multi-source BFS, 64 sources: V=" << n << " E=" << g.getNumEdges() << " "
+         << chrono::duration<double, milli>(end - start).count() << " ms" << endl;
+    delete[] distances;
+}
+
+int main() {
+    benchmarkSorts(256);
+    benchmarkSorts(1000000);
+    CSRGraph g = randomGraph(1 << 20, 8);
+    benchmarkKruskal(g);
+    benchmarkBfs(g);
+    benchmarkBfs(gridGraph(1000, 100));
+    benchmarkMultiSourceBfs(g);
+    benchmarkShortestPaths(g);
+    benchmarkShortestPaths(gridGraph(300, 100));
+    benchmarkPointToPoint(g);
+    return 0;
+}
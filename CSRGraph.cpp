@@ -0,0 +1,208 @@
+// email:shmuel.benatar@msmail.ariel.ac.il
+#include "CSRGraph.h"
+#include <stdexcept>
+#include <fstream>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace graph {
+
+// Snapshot header, see CSRGraph.h for the file layout
+struct SnapshotHeader {
+    char magic[8];
+    unsigned int version;
+    unsigned int byteOrder;
+    long long numVertices;
+    long long numEntries;
+};
+
+static const char SNAPSHOT_MAGIC[8] = {'C', 'S', 'R', 'G', 'R', 'A', 'P', 'H'};
+static const unsigned int SNAPSHOT_VERSION = 1;
+static const unsigned int SNAPSHOT_BYTE_ORDER = 0x01020304;
+
+// Build the CSR arrays from the adjacency lists of g.
+// The first walk counts the degrees, the second fills each row
+// in the same order as the original adjacency list.
+CSRGraph::CSRGraph(const Graph& g)
+    : numVertices(g.getNumVertices()), numEntries(0), mapping(nullptr), mappingSize(0), edgeChecksum(0) {
+    this->offsets = new int[numVertices + 1];
+    this->offsets[0] = 0;
+    for (int u = 0; u < numVertices; ++u) {
+        int deg = 0;
+        for (Node* curr = g.getAdjList(u); curr != nullptr; curr = curr->next) {
+            ++deg;
+        }
+        this->offsets[u + 1] = this->offsets[u] + deg;
+    }
+    this->numEntries = this->offsets[numVertices];
+
+    this->neighbors = new int[numEntries];
+    this->weights = new int[numEntries];
+    for (int u = 0; u < numVertices; ++u) {
+        int pos = this->offsets[u];
+        for (Node* curr = g.getAdjList(u); curr != nullptr; curr = curr->next) {
+            this->neighbors[pos] = curr->vertex;
+            this->weights[pos] = curr->weight;
+            ++pos;
+            if (u < curr->vertex)
+                edgeChecksum += edgeFingerprint(u, curr->vertex, curr->weight);
+        }
+    }
+}
+
+// Snapshot Constructor
+// Maps the file read-only and points the arrays into it.
+// Besides the header and the file size, one pass checks that the offsets never
+// decrease and every neighbor is a vertex, so a corrupt or truncated snapshot is
+// rejected here instead of sending the algorithms out of bounds. The same pass
+// sums the edge checksum.
+CSRGraph::CSRGraph(const std::string& snapshotPath)
+    : numVertices(0), numEntries(0), offsets(nullptr), neighbors(nullptr), weights(nullptr),
+      mapping(nullptr), mappingSize(0), edgeChecksum(0) {
+    int fd = open(snapshotPath.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw runtime_error("Cannot open snapshot " + snapshotPath);
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(SnapshotHeader))) {
+        close(fd);
+        throw runtime_error("Invalid snapshot " + snapshotPath);
+    }
+    size_t size = static_cast<size_t>(info.st_size);
+    void* data = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd); // The mapping stays valid after the descriptor is closed
+    if (data == MAP_FAILED) {
+        throw runtime_error("Cannot map snapshot " + snapshotPath);
+    }
+
+    const SnapshotHeader* header = static_cast<const SnapshotHeader*>(data);
+    bool valid = memcmp(header->magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) == 0 &&
+                 header->version == SNAPSHOT_VERSION && header->byteOrder == SNAPSHOT_BYTE_ORDER &&
+                 header->numVertices > 0 && header->numVertices < 2147483647LL &&
+                 header->numEntries >= 0 && header->numEntries <= 2147483647LL;
+    if (valid) {
+        long long expected = static_cast<long long>(sizeof(SnapshotHeader)) +
+                             4LL * (header->numVertices + 1 + 2 * header->numEntries);
+        valid = expected == static_cast<long long>(size);
+    }
+    if (!valid) {
+        munmap(data, size);
+        throw runtime_error("Invalid snapshot " + snapshotPath);
+    }
+
+    // The mapping is read-only, the arrays are only ever read through const members
+    int* base = reinterpret_cast<int*>(static_cast<char*>(data) + sizeof(SnapshotHeader));
+    numVertices = static_cast<int>(header->numVertices);
+    numEntries = static_cast<int>(header->numEntries);
+    offsets = base;
+    neighbors = base + numVertices + 1;
+    weights = neighbors + numEntries;
+
+    valid = offsets[0] == 0 && offsets[numVertices] == numEntries;
+    for (int v = 0; valid && v < numVertices; ++v) {
+        valid = offsets[v] <= offsets[v + 1];
+    }
+    for (int u = 0; valid && u < numVertices; ++u) {
+        for (int i = offsets[u]; valid && i < offsets[u + 1]; ++i) {
+            valid = neighbors[i] >= 0 && neighbors[i] < numVertices;
+            if (u < neighbors[i])
+                edgeChecksum += edgeFingerprint(u, neighbors[i], weights[i]);
+        }
+    }
+    if (!valid) {
+        munmap(data, size);
+        throw runtime_error("Invalid snapshot " + snapshotPath);
+    }
+    mapping = data;
+    mappingSize = size;
+}
+
+// Write the header and the three arrays in the snapshot layout
+void CSRGraph::save(const std::string& path) const {
+    ofstream out(path, ios::binary | ios::trunc);
+    if (!out) {
+        throw runtime_error("Cannot create snapshot " + path);
+    }
+
+    SnapshotHeader header;
+    memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+    header.version = SNAPSHOT_VERSION;
+    header.byteOrder = SNAPSHOT_BYTE_ORDER;
+    header.numVertices = numVertices;
+    header.numEntries = numEntries;
+
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(offsets), sizeof(int) * (static_cast<size_t>(numVertices) + 1));
+    out.write(reinterpret_cast<const char*>(neighbors), sizeof(int) * static_cast<size_t>(numEntries));
+    out.write(reinterpret_cast<const char*>(weights), sizeof(int) * static_cast<size_t>(numEntries));
+    out.close();
+    if (!out) {
+        throw runtime_error("Cannot write snapshot " + path);
+    }
+}
+
+// Deep Copy Constructor
+// Copying a mapped graph produces an ordinary graph that owns its arrays
+CSRGraph::CSRGraph(const CSRGraph& other) {
+    copyFrom(other);
+}
+
+// Assignment Operator (Rule of Three)
+CSRGraph& CSRGraph::operator=(const CSRGraph& other) {
+    if (this == &other)
+        return *this;
+
+    release();
+    copyFrom(other);
+
+    return *this;
+}
+
+// Destructor
+CSRGraph::~CSRGraph() {
+    release();
+}
+
+// Helper that frees owned arrays or unmaps the snapshot
+void CSRGraph::release() {
+    if (mapping != nullptr) {
+        munmap(mapping, mappingSize);
+        mapping = nullptr;
+        mappingSize = 0;
+    } else {
+        delete[] this->offsets;
+        delete[] this->neighbors;
+        delete[] this->weights;
+    }
+}
+
+// Helper that allocates and copies all arrays of other
+void CSRGraph::copyFrom(const CSRGraph& other) {
+    numVertices = other.numVertices;
+    numEntries = other.numEntries;
+    mapping = nullptr;
+    mappingSize = 0;
+    edgeChecksum = other.edgeChecksum;
+    offsets = new int[numVertices + 1];
+    neighbors = new int[numEntries];
+    weights = new int[numEntries];
+    for (int i = 0; i <= numVertices; ++i) {
+        offsets[i] = other.offsets[i];
+    }
+    for (int i = 0; i < numEntries; ++i) {
+        neighbors[i] = other.neighbors[i];
+        weights[i] = other.weights[i];
+    }
+}
+
+// Get the number of neighbors of a specific vertex
+int CSRGraph::degree(int v) const {
+    if (v < 0 || v >= numVertices)
+        throw out_of_range("Invalid vertex index");
+    return offsets[v + 1] - offsets[v];
+}
+
+} // namespace graph
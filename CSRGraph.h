@@ -0,0 +1,65 @@
+// email:shmuel.benatar@msmail.ariel.ac.il
+#ifndef CSR_GRAPH_H
+#define CSR_GRAPH_H
+
+#include "Graph.h"
+#include <string>
+#include <cstddef>
+
+namespace graph {
+
+// Immutable compressed sparse row (CSR) form of a Graph.
+// The neighbors of vertex v are stored contiguously in
+// neighbors[offsets[v]] .. neighbors[offsets[v + 1] - 1],
+// with the matching edge weights at the same positions in weights.
+// Each undirected edge appears twice, once in each endpoint's row.
+//
+// A CSRGraph can be saved as a binary snapshot and opened again with mmap.
+// Snapshot layout (native byte order):
+//   header:    8-byte magic "CSRGRAPH", uint32 version, uint32 byte order mark,
+//              int64 numVertices, int64 numEntries (32 bytes)
+//   offsets:   numVertices + 1 int32
+//   neighbors: numEntries int32
+//   weights:   numEntries int32
+// A mapped graph points straight into the file pages, nothing is copied; opening
+// checks the rows in one O(V + E) pass.
+class CSRGraph {
+private:
+    int numVertices;
+    int numEntries; // Number of adjacency entries (twice the number of edges)
+    int* offsets;   // numVertices + 1 row boundaries
+    int* neighbors;
+    int* weights;
+    void* mapping;  // Snapshot mapping the arrays point into, nullptr if they are owned
+    size_t mappingSize;
+    unsigned long long edgeChecksum; // Sum of edgeFingerprint over all edges, as Graph keeps it
+
+public:
+    CSRGraph(const Graph& g); // Freeze an existing graph
+    explicit CSRGraph(const std::string& snapshotPath); // Map a snapshot read-only
+    CSRGraph(const CSRGraph& other); // Deep copy constructor
+    CSRGraph& operator=(const CSRGraph& other); // Assignment operator
+    ~CSRGraph();
+
+    int getNumVertices() const { return numVertices; }
+    int getNumEntries() const { return numEntries; }
+    int getNumEdges() const { return numEntries / 2; }
+    int degree(int v) const;
+    bool isMapped() const { return mapping != nullptr; }
+    unsigned long long getEdgeChecksum() const { return edgeChecksum; }
+
+    void save(const std::string& path) const; // Write a binary snapshot
+
+    // Raw row access for the algorithms, no range checks.
+    // getOffset accepts v in [0, numVertices], entries are in [0, numEntries).
+    int getOffset(int v) const { return offsets[v]; }
+    int getNeighbor(int entry) const { return neighbors[entry]; }
+    int getWeight(int entry) const { return weights[entry]; }
+
+private:
+    void copyFrom(const CSRGraph& other);
+    void release();
+};
+
+} // namespace graph
+#endif
@@ -52,131 +52,540 @@ namespace graph
     }
 
     // =========== Priority Queue =========================
+    // The queue is an indexed binary min-heap.
+    // data holds the heap itself, ordered by priority.
+    // position maps an index to its slot in data (-1 if not in the queue),
+    // so contains is O(1) and insert/extractMin/decreasePriority are O(log n).
     // Constructor initializes the priority queue with a maximum size.
     // Destructor cleans up the allocated memory.
     // insert adds an element with a specific index and priority to the queue.
     // extractMin removes and returns the index of the element with the lowest priority.
+    // minPriority returns that lowest priority without removing anything.
     // decreasePriority updates the priority of an existing element.
     // contains checks if a specific index is present in the queue.
     // isEmpty checks if the priority queue is empty.
+    // clear removes every element.
     // If the queue is full, an overflow error is thrown. 
-    PriorityQueue::PriorityQueue(int maxSize) : capacity(maxSize), size(0){
+    PriorityQueue::PriorityQueue(int maxSize) : capacity(maxSize), positionCapacity(maxSize), size(0){
         data = new PQNode[capacity];
+        position = new int[positionCapacity];
+        for (int i = 0; i < positionCapacity; ++i){
+            position[i] = -1;
+        }
     }
 
     PriorityQueue::~PriorityQueue(){
         delete[] data;
+        delete[] position;
+    }
+
+    // Swap two heap slots and keep the position map in sync
+    void PriorityQueue::swapNodes(int a, int b){
+        PQNode temp = data[a];
+        data[a] = data[b];
+        data[b] = temp;
+        position[data[a].index] = a;
+        position[data[b].index] = b;
+    }
+
+    void PriorityQueue::siftUp(int pos){
+        while (pos > 0){
+            int parent = (pos - 1) / 2;
+            if (data[parent].priority <= data[pos].priority)
+                break;
+            swapNodes(pos, parent);
+            pos = parent;
+        }
+    }
+
+    void PriorityQueue::siftDown(int pos){
+        while (true){
+            int left = 2 * pos + 1;
+            if (left >= size)
+                break;
+            int smallest = left;
+            int right = left + 1;
+            if (right < size && data[right].priority < data[left].priority)
+                smallest = right;
+            if (data[pos].priority <= data[smallest].priority)
+                break;
+            swapNodes(pos, smallest);
+            pos = smallest;
+        }
+    }
+
+    // Indices are not bounded by the capacity, so the position map
+    // grows on demand when a larger index is inserted
+    void PriorityQueue::growPositions(int index){
+        int newCapacity = positionCapacity * 2;
+        if (newCapacity <= index)
+            newCapacity = index + 1;
+
+        int* newPosition = new int[newCapacity];
+        for (int i = 0; i < positionCapacity; ++i){
+            newPosition[i] = position[i];
+        }
+        for (int i = positionCapacity; i < newCapacity; ++i){
+            newPosition[i] = -1;
+        }
+        delete[] position;
+        position = newPosition;
+        positionCapacity = newCapacity;
     }
 
     void PriorityQueue::insert(int index, int priority){
         if (size == capacity){
             throw std::overflow_error("Priority Queue is full");
         }
+        if (index < 0){
+            throw std::invalid_argument("Index must be non-negative");
+        }
         // Check if the index already exists in the queue
         if (contains(index)){
             throw std::invalid_argument("Index already exists in the priority queue");
         }
+        if (index >= positionCapacity){
+            growPositions(index);
+        }
 
-        data[size++] = {index, priority};
+        data[size] = {index, priority};
+        position[index] = size;
+        siftUp(size++);
     }
 
     int PriorityQueue::extractMin(){
         if (isEmpty())
         throw std::out_of_range("Priority Queue is empty");
-        if (size == 1){
-            --size;
-            return data[0].index; // Return the only element
-        }
-        // Find the minimum priority element
-        int minPos = 0; // position in array
-        for (int i = 1; i < size; ++i){
-            if (data[i].priority < data[minPos].priority)
-                minPos = i;
-        }
 
-        int minIndex = data[minPos].index; // the real index to return
+        int minIndex = data[0].index; // the real index to return
+        position[minIndex] = -1;
 
-        data[minPos] = data[size - 1];
         --size;
+        if (size > 0){
+            // Move the last element to the root and restore the heap
+            data[0] = data[size];
+            position[data[0].index] = 0;
+            siftDown(0);
+        }
 
         return minIndex;
     }
 
     void PriorityQueue::decreasePriority(int index, int newPriority){
-        for (int i = 0; i < size; ++i) {
-            if (data[i].index == index) {
-                if (newPriority > data[i].priority)
-                    throw std::invalid_argument("New priority is higher than current priority");
-                if (newPriority == data[i].priority)
-                    return;
-                data[i].priority = newPriority;
-                return;
-            }
-        }
-        throw std::invalid_argument("Index not found in priority queue");
+        if (!contains(index))
+            throw std::invalid_argument("Index not found in priority queue");
+
+        int pos = position[index];
+        if (newPriority > data[pos].priority)
+            throw std::invalid_argument("New priority is higher than current priority");
+        if (newPriority == data[pos].priority)
+            return;
+        data[pos].priority = newPriority;
+        siftUp(pos);
     }
+
+    int PriorityQueue::minPriority() const{
+        if (isEmpty())
+            throw std::out_of_range("Priority Queue is empty");
+        return data[0].priority;
+    }
+
     bool PriorityQueue::contains(int index) const{
-        for (int i = 0; i < size; ++i){
-            if (data[i].index == index)
-                return true;
-        }
-        return false;
+        return index >= 0 && index < positionCapacity && position[index] != -1;
     }
 
     bool PriorityQueue::isEmpty() const{
         return size == 0;
     }
 
+    // Only the indices still in the heap have a position to forget,
+    // so a queue reused across searches is emptied without an O(maxSize) pass
+    void PriorityQueue::clear(){
+        for (int i = 0; i < size; ++i){
+            position[data[i].index] = -1;
+        }
+        size = 0;
+    }
+
+    // ============= Edge Map ========
+    // Keys are non-negative, EMPTY_KEY marks a free slot.
+    // slotOf returns the slot holding key, or the free slot where it would go.
+    // insert throws if the key already exists or is negative.
+    // erase shifts the following cluster back so lookups never need tombstones.
+    // Capacities are powers of two held in an int, so 2^30 slots is the most a
+    // table can have; growth is computed in long long and throws beyond that.
+    static const long long EMPTY_KEY = -1;
+    static const int MIN_EDGE_MAP_CAPACITY = 16;
+    static const int MAX_EDGE_MAP_CAPACITY = 1 << 30;
+
+    // splitmix64 finalizer, spreads consecutive keys over the table
+    static unsigned long long hashKey(long long key){
+        unsigned long long x = static_cast<unsigned long long>(key);
+        x ^= x >> 30;
+        x *= 0xbf58476d1ce4e5b9ULL;
+        x ^= x >> 27;
+        x *= 0x94d049bb133111ebULL;
+        x ^= x >> 31;
+        return x;
+    }
+
+    EdgeMap::EdgeMap(int expected) : keys(nullptr), values(nullptr), capacity(0), size(0){
+        rehash(MIN_EDGE_MAP_CAPACITY);
+        reserve(expected);
+    }
+
+    EdgeMap::~EdgeMap(){
+        delete[] keys;
+        delete[] values;
+    }
+
+    EdgeMap::EdgeMap(EdgeMap&& other) noexcept
+        : keys(other.keys), values(other.values), capacity(other.capacity), size(other.size){
+        other.keys = nullptr;
+        other.values = nullptr;
+        other.capacity = 0;
+        other.size = 0;
+    }
+
+    EdgeMap& EdgeMap::operator=(EdgeMap&& other) noexcept{
+        if (this == &other)
+            return *this;
+
+        delete[] keys;
+        delete[] values;
+        keys = other.keys;
+        values = other.values;
+        capacity = other.capacity;
+        size = other.size;
+        other.keys = nullptr;
+        other.values = nullptr;
+        other.capacity = 0;
+        other.size = 0;
+
+        return *this;
+    }
+
+    int EdgeMap::slotOf(long long key) const{
+        int mask = capacity - 1;
+        int slot = static_cast<int>(hashKey(key) & mask);
+        while (keys[slot] != EMPTY_KEY && keys[slot] != key){
+            slot = (slot + 1) & mask;
+        }
+        return slot;
+    }
+
+    void EdgeMap::rehash(int newCapacity){
+        long long* oldKeys = keys;
+        Node** oldValues = values;
+        int oldCapacity = capacity;
+
+        keys = new long long[newCapacity];
+        values = new Node*[newCapacity];
+        capacity = newCapacity;
+        for (int i = 0; i < capacity; ++i){
+            keys[i] = EMPTY_KEY;
+            values[i] = nullptr;
+        }
+
+        for (int i = 0; i < oldCapacity; ++i){
+            if (oldKeys[i] != EMPTY_KEY){
+                int slot = slotOf(oldKeys[i]);
+                keys[slot] = oldKeys[i];
+                values[slot] = oldValues[i];
+            }
+        }
+
+        delete[] oldKeys;
+        delete[] oldValues;
+    }
+
+    void EdgeMap::insert(long long key, Node* value){
+        if (key < 0){
+            throw std::invalid_argument("Edge key must be non-negative");
+        }
+        if (capacity == 0){
+            rehash(MIN_EDGE_MAP_CAPACITY);
+        }
+        int slot = slotOf(key);
+        if (keys[slot] == key){
+            throw std::invalid_argument("Key already exists in the edge map");
+        }
+        keys[slot] = key;
+        values[slot] = value;
+        ++size;
+        if (2LL * size > capacity){
+            if (capacity == MAX_EDGE_MAP_CAPACITY){
+                erase(key);
+                throw std::length_error("Edge map is full");
+            }
+            rehash(capacity * 2);
+        }
+    }
+
+    Node* EdgeMap::find(long long key) const{
+        if (capacity == 0 || key < 0)
+            return nullptr;
+        int slot = slotOf(key);
+        return keys[slot] == key ? values[slot] : nullptr;
+    }
+
+    bool EdgeMap::erase(long long key){
+        if (capacity == 0 || key < 0)
+            return false;
+        int slot = slotOf(key);
+        if (keys[slot] != key)
+            return false;
+
+        // Backward-shift: move later entries of the cluster into the hole
+        // unless their home slot lies cyclically in (hole, current]
+        int mask = capacity - 1;
+        int hole = slot;
+        int next = (hole + 1) & mask;
+        while (keys[next] != EMPTY_KEY){
+            int home = static_cast<int>(hashKey(keys[next]) & mask);
+            bool stays = (hole <= next) ? (hole < home && home <= next) : (hole < home || home <= next);
+            if (!stays){
+                keys[hole] = keys[next];
+                values[hole] = values[next];
+                hole = next;
+            }
+            next = (next + 1) & mask;
+        }
+        keys[hole] = EMPTY_KEY;
+        values[hole] = nullptr;
+        --size;
+        return true;
+    }
+
+    // Grow the table once so count entries fit without further rehashing
+    void EdgeMap::reserve(int count){
+        long long needed = capacity == 0 ? MIN_EDGE_MAP_CAPACITY : capacity;
+        while (needed < 2LL * count){
+            needed *= 2;
+        }
+        if (needed > MAX_EDGE_MAP_CAPACITY){
+            throw std::length_error("Edge map cannot hold that many entries");
+        }
+        if (needed != capacity){
+            rehash(static_cast<int>(needed));
+        }
+    }
+
+    void EdgeMap::clear(){
+        for (int i = 0; i < capacity; ++i){
+            keys[i] = EMPTY_KEY;
+            values[i] = nullptr;
+        }
+        size = 0;
+    }
+
     // ============= Union Find ========
-    // Constructor initializes the Union-Find structure with a given size.
-    // Destructor cleans up the allocated memory.       
-    // find returns the root of the set containing x, applying path compression.
-    // unite merges the sets containing x and y, using union by rank.
-    // If x and y are already in the same set, no action is taken.
-    // If the size is invalid, an exception is thrown.
-    // If the union operation fails, an exception is thrown.
-    // If the find operation fails, an exception is thrown.
-    // If the union operation is successful, the function returns without any value.
-    // If the find operation is successful, the function returns the root of the set containing x.
-    // If the union operation is successful, the function returns without any value.    
-    UnionFind::UnionFind(int n) : size(n){
+    // Constructor makes every element a set of its own.
+    // Destructor cleans up the allocated memory.
+    // find returns the root of the set containing x. It walks up iteratively and
+    // points every other node on the way at its grandparent (path halving).
+    // unite merges the sets containing x and y, linking the smaller set under the
+    // larger one, and returns false if they were already the same set.
+    // setSize returns the size of the set containing x, numSets the number of sets.
+    // An invalid size or index throws an exception.
+    UnionFind::UnionFind(int n) : size(n), sets(n){
+        if (n <= 0){
+            throw std::invalid_argument("Size must be positive");
+        }
         parent = new int[size];
-        rank = new int[size];
+        setSizes = new int[size];
 
         for (int i = 0; i < size; ++i){
             parent[i] = i;
-            rank[i] = 0;
+            setSizes[i] = 1;
         }
     }
 
     UnionFind::~UnionFind(){
         delete[] parent;
-        delete[] rank;
+        delete[] setSizes;
     }
 
     int UnionFind::find(int x){
-        if (parent[x] != x)
-            parent[x] = find(parent[x]);
-        return parent[x];
+        if (x < 0 || x >= size){
+            throw std::out_of_range("Index out of range");
+        }
+        while (parent[x] != x){
+            parent[x] = parent[parent[x]];
+            x = parent[x];
+        }
+        return x;
     }
 
-    void UnionFind::unite(int x, int y){
+    bool UnionFind::unite(int x, int y){
         int rootX = find(x);
         int rootY = find(y);
 
         if (rootX == rootY)
-            return;
+            return false;
+
+        if (setSizes[rootX] < setSizes[rootY]){
+            int temp = rootX;
+            rootX = rootY;
+            rootY = temp;
+        }
+        parent[rootY] = rootX;
+        setSizes[rootX] += setSizes[rootY];
+        --sets;
+        return true;
+    }
+
+    int UnionFind::setSize(int x){
+        return setSizes[find(x)];
+    }
+
+    // ============= Rollback Union Find ========
+    // Constructor makes every element a set of its own with an empty history.
+    // find walks up to the root without changing any parent.
+    // unite links the smaller root under the larger one and records it; at most
+    // n - 1 unites succeed, so the history never outgrows n entries.
+    // rollback pops the history down to a mark from snapshot(), restoring sizes.
+    // An invalid size, index or mark throws an exception.
+    RollbackUnionFind::RollbackUnionFind(int n) : historySize(0), size(n), sets(n){
+        if (n <= 0){
+            throw std::invalid_argument("Size must be positive");
+        }
+        parent = new int[size];
+        setSizes = new int[size];
+        history = new int[size];
+
+        for (int i = 0; i < size; ++i){
+            parent[i] = i;
+            setSizes[i] = 1;
+        }
+    }
+
+    RollbackUnionFind::~RollbackUnionFind(){
+        delete[] parent;
+        delete[] setSizes;
+        delete[] history;
+    }
+
+    int RollbackUnionFind::find(int x) const{
+        if (x < 0 || x >= size){
+            throw std::out_of_range("Index out of range");
+        }
+        while (parent[x] != x){
+            x = parent[x];
+        }
+        return x;
+    }
+
+    bool RollbackUnionFind::unite(int x, int y){
+        int rootX = find(x);
+        int rootY = find(y);
+
+        if (rootX == rootY)
+            return false;
+
+        if (setSizes[rootX] < setSizes[rootY]){
+            int temp = rootX;
+            rootX = rootY;
+            rootY = temp;
+        }
+        parent[rootY] = rootX;
+        setSizes[rootX] += setSizes[rootY];
+        history[historySize++] = rootY;
+        --sets;
+        return true;
+    }
+
+    int RollbackUnionFind::setSize(int x) const{
+        return setSizes[find(x)];
+    }
 
-        if (rank[rootX] < rank[rootY]){
-            parent[rootX] = rootY;
+    void RollbackUnionFind::rollback(int mark){
+        if (mark < 0 || mark > historySize){
+            throw std::invalid_argument("Invalid snapshot");
         }
-        else if (rank[rootX] > rank[rootY]){
-            parent[rootY] = rootX;
+        while (historySize > mark){
+            int child = history[--historySize];
+            int root = parent[child];
+            setSizes[root] -= setSizes[child];
+            parent[child] = child;
+            ++sets;
         }
-        else{
-            parent[rootY] = rootX;
-            rank[rootX]++;
+    }
+
+    // ============= Concurrent Union Find ========
+    // Constructor makes every element its own root.
+    // find returns the current root of x. Each step tries to point x at its
+    // grandparent (path splitting), so paths shrink while threads walk them.
+    // unite repeatedly finds both roots and tries to CAS the lower priority root
+    // to the other one; a failed CAS means the root changed and it starts over.
+    // sameSet is linearizable: x and y are in different sets only if the root of
+    // x is still a root after the root of y was found.
+    // If an index is out of range, an exception is thrown.
+    ConcurrentUnionFind::ConcurrentUnionFind(int n) : size(n){
+        if (n <= 0){
+            throw std::invalid_argument("Size must be positive");
+        }
+        parent = new std::atomic<int>[size];
+        for (int i = 0; i < size; ++i){
+            parent[i].store(i, std::memory_order_relaxed);
+        }
+    }
+
+    ConcurrentUnionFind::~ConcurrentUnionFind(){
+        delete[] parent;
+    }
+
+    // Priority of an element: a scrambled copy of its index, ties broken by index
+    bool ConcurrentUnionFind::lowerPriority(int x, int y) const{
+        unsigned int px = static_cast<unsigned int>(x) * 2654435761u;
+        unsigned int py = static_cast<unsigned int>(y) * 2654435761u;
+        return px < py || (px == py && x < y);
+    }
+
+    int ConcurrentUnionFind::find(int x){
+        if (x < 0 || x >= size){
+            throw std::out_of_range("Index out of range");
+        }
+        while (true){
+            int p = parent[x].load(std::memory_order_acquire);
+            if (p == x)
+                return x;
+            int grandparent = parent[p].load(std::memory_order_acquire);
+            if (p != grandparent){
+                // Splitting is only an optimization, losing the race is fine
+                parent[x].compare_exchange_weak(p, grandparent, std::memory_order_acq_rel);
+            }
+            x = p;
+        }
+    }
+
+    bool ConcurrentUnionFind::unite(int x, int y){
+        while (true){
+            x = find(x);
+            y = find(y);
+            if (x == y)
+                return false;
+            if (!lowerPriority(x, y)){
+                int temp = x;
+                x = y;
+                y = temp;
+            }
+            // x has the lower priority and goes under y, only if x is still a root
+            int expected = x;
+            if (parent[x].compare_exchange_strong(expected, y, std::memory_order_acq_rel))
+                return true;
+        }
+    }
+
+    bool ConcurrentUnionFind::sameSet(int x, int y){
+        while (true){
+            x = find(x);
+            y = find(y);
+            if (x == y)
+                return true;
+            if (parent[x].load(std::memory_order_acquire) == x)
+                return false;
         }
     }
 
-} // namespace graph
\ No newline at end of file
+} // namespace graph
@@ -3,6 +3,7 @@
 #define DATA_STRUCTURES_H
 
 #include <stdexcept>
+#include <atomic>
 
 namespace graph {
 
@@ -32,36 +33,140 @@ struct PQNode {
     int priority;
 };
 
+// Indexed binary min-heap: position[index] holds the heap slot of index
+// (or -1), so contains is O(1) and extractMin/decreasePriority are O(log n).
 class PriorityQueue {
 private:
     PQNode* data;
+    int* position;
     int capacity;
+    int positionCapacity;
     int size;
 
+    void siftUp(int pos);
+    void siftDown(int pos);
+    void swapNodes(int a, int b);
+    void growPositions(int index);
+
 public:
     PriorityQueue(int maxSize);
     ~PriorityQueue();
 
     void insert(int index, int priority);
     int extractMin();
+    int minPriority() const; // Priority of the element extractMin would return
     void decreasePriority(int index, int newPriority);
     bool contains(int index) const;
     bool isEmpty() const;
+    void clear(); // Empties the queue in O(size), keeping its storage
+};
+
+// ===== Edge Map =======
+struct Node;
+
+// Open-addressing hash map from an edge key to its adjacency node.
+// Linear probing with backward-shift deletion, so erase leaves no tombstones.
+// The table is a power of two and is kept at most half full.
+class EdgeMap {
+private:
+    long long* keys; // EMPTY_KEY marks a free slot
+    Node** values;
+    int capacity;
+    int size;
+
+    int slotOf(long long key) const;
+    void rehash(int newCapacity);
+
+public:
+    EdgeMap(int expected = 0);
+    ~EdgeMap();
+    EdgeMap(const EdgeMap&) = delete;
+    EdgeMap& operator=(const EdgeMap&) = delete;
+    EdgeMap(EdgeMap&& other) noexcept;
+    EdgeMap& operator=(EdgeMap&& other) noexcept;
+
+    void insert(long long key, Node* value);
+    Node* find(long long key) const; // nullptr if the key is absent
+    bool erase(long long key);
+    void reserve(int count);
+    void clear();
+    int getSize() const { return size; }
 };
 
 // ===== Union Find =======
+// find is iterative with path halving, so deep trees cannot overflow the stack.
+// unite links the smaller set under the larger one (union by size), which also
+// keeps every root's set size and the number of sets available in O(1).
 class UnionFind {
 private:
     int* parent;
-    int* rank;
+    int* setSizes; // Only meaningful at roots
     int size;
+    int sets;
 
 public:
     UnionFind(int n);
     ~UnionFind();
+    UnionFind(const UnionFind&) = delete;
+    UnionFind& operator=(const UnionFind&) = delete;
+
+    int find(int x);
+    bool unite(int x, int y); // True if x and y were in different sets
+    int setSize(int x);       // Number of elements in the set containing x
+    int numSets() const { return sets; }
+};
+
+// ===== Rollback Union Find =======
+// Union by size without path compression, so every unite changes exactly one
+// parent and can be undone. find is O(log n). snapshot() marks the current state
+// and rollback(mark) undoes every unite made after it, most recent first.
+class RollbackUnionFind {
+private:
+    int* parent;
+    int* setSizes; // Only meaningful at roots
+    int* history;  // Roots linked under another root, in unite order
+    int historySize;
+    int size;
+    int sets;
+
+public:
+    RollbackUnionFind(int n);
+    ~RollbackUnionFind();
+    RollbackUnionFind(const RollbackUnionFind&) = delete;
+    RollbackUnionFind& operator=(const RollbackUnionFind&) = delete;
+
+    int find(int x) const;
+    bool unite(int x, int y); // True if x and y were in different sets
+    int setSize(int x) const;
+    int numSets() const { return sets; }
+
+    int snapshot() const { return historySize; }
+    void rollback(int mark);
+};
+
+// ===== Concurrent Union Find =======
+// Lock-free union-find that many threads can use at the same time.
+// find uses path splitting with CAS (a failed CAS just means another thread
+// already shortened the path), unite links one root under the other with a
+// single CAS and retries if either root changed meanwhile.
+// Roots are linked by a fixed pseudo-random priority per element, which keeps
+// the trees shallow in expectation without storing ranks.
+class ConcurrentUnionFind {
+private:
+    std::atomic<int>* parent;
+    int size;
+
+    bool lowerPriority(int x, int y) const;
+
+public:
+    ConcurrentUnionFind(int n);
+    ~ConcurrentUnionFind();
+    ConcurrentUnionFind(const ConcurrentUnionFind&) = delete;
+    ConcurrentUnionFind& operator=(const ConcurrentUnionFind&) = delete;
 
     int find(int x);
-    void unite(int x, int y);
+    bool unite(int x, int y); // True if x and y were in different sets
+    bool sameSet(int x, int y);
 };
 
 } // namespace graph
@@ -1,9 +1,95 @@
 // email:shmuel.benatar@msmail.ariel.ac.il
 #include "Graph.h"
 #include <stdexcept>
+#include <new>
+#include <utility>
 
 namespace graph {
 
+// ============ Node Pool =======
+// Blocks are raw memory, nodes are constructed in place on allocate.
+// Block sizes double from 64 nodes up to 1M nodes, reserve can request
+// one exact block (used when the final node count is known up front).
+// Node is trivially destructible so freeing a block frees its nodes.
+static const int FIRST_BLOCK_SIZE = 64;
+static const int MAX_BLOCK_SIZE = 1 << 20;
+
+NodePool::NodePool() : blocks(nullptr), freeList(nullptr), nextBlockSize(FIRST_BLOCK_SIZE) {}
+
+NodePool::~NodePool() {
+    clear();
+}
+
+NodePool::NodePool(NodePool&& other) noexcept
+    : blocks(other.blocks), freeList(other.freeList), nextBlockSize(other.nextBlockSize) {
+    other.blocks = nullptr;
+    other.freeList = nullptr;
+    other.nextBlockSize = FIRST_BLOCK_SIZE;
+}
+
+NodePool& NodePool::operator=(NodePool&& other) noexcept {
+    if (this == &other)
+        return *this;
+
+    clear();
+    blocks = other.blocks;
+    freeList = other.freeList;
+    nextBlockSize = other.nextBlockSize;
+    other.blocks = nullptr;
+    other.freeList = nullptr;
+    other.nextBlockSize = FIRST_BLOCK_SIZE;
+
+    return *this;
+}
+
+void NodePool::addBlock(int capacity) {
+    Block* block = new Block;
+    block->nodes = static_cast<Node*>(::operator new(sizeof(Node) * capacity));
+    block->capacity = capacity;
+    block->used = 0;
+    block->next = blocks;
+    blocks = block;
+}
+
+Node* NodePool::allocate(int vertex, int weight, Node* next) {
+    if (freeList != nullptr) {
+        Node* node = freeList;
+        freeList = freeList->next;
+        return new (node) Node(vertex, weight, next);
+    }
+    if (blocks == nullptr || blocks->used == blocks->capacity) {
+        addBlock(nextBlockSize);
+        if (nextBlockSize < MAX_BLOCK_SIZE)
+            nextBlockSize *= 2;
+    }
+    return new (&blocks->nodes[blocks->used++]) Node(vertex, weight, next);
+}
+
+void NodePool::release(Node* node) {
+    node->next = freeList;
+    freeList = node;
+}
+
+void NodePool::reserve(int count) {
+    if (count <= 0)
+        return;
+    if (blocks != nullptr && blocks->capacity - blocks->used >= count)
+        return;
+    addBlock(count);
+}
+
+void NodePool::clear() {
+    while (blocks != nullptr) {
+        Block* next = blocks->next;
+        ::operator delete(blocks->nodes);
+        delete blocks;
+        blocks = next;
+    }
+    freeList = nullptr;
+    nextBlockSize = FIRST_BLOCK_SIZE;
+}
+
+
 
 // Constructor
 Graph::Graph(int vertices) : numVertices(vertices) {
@@ -17,35 +103,122 @@ Graph::Graph(int vertices) : numVertices(vertices) {
     }
     this->visitOrder = new int[numVertices];
     this->visitCount = 0; // Initialize visit count to 0
+    this->edgeChecksum = 0;
 }
 
-// Deep Copy Constructor
-Graph::Graph(const Graph& other) : numVertices(other.numVertices) {
-    adjacencyList = new Node*[numVertices];
+// Helper for bulk construction: stable counting sort of the permutation in
+// by key[in[i]], where every key is in [0, range). The result is written to out.
+static void countingSortBy(const int* key, int range, int count, const int* in, int* out) {
+    int* start = new int[range + 1]();
+    for (int i = 0; i < count; ++i) {
+        ++start[key[in[i]] + 1];
+    }
+    for (int k = 0; k < range; ++k) {
+        start[k + 1] += start[k];
+    }
+    for (int i = 0; i < count; ++i) {
+        out[start[key[in[i]]]++] = in[i];
+    }
+    delete[] start;
+}
 
-    // Copy each adjacency list
+// Bulk Constructor
+// Every edge becomes two adjacency entries, and edgeIndex keeps its load at most
+// one half in a table of at most 2^30 slots (int capacity, power of two), so it
+// holds at most 2^29 entries: edgeCount may be at most 2^28
+static const int MAX_BULK_EDGES = 1 << 28;
+
+// Builds the graph from a whole edge array at once instead of edgeCount addEdge calls:
+// 1. One validation pass (vertex range, self-loops), nothing is allocated for the graph yet.
+// 2. The 2 * edgeCount adjacency entries are sorted by (source, neighbor) with two
+//    linear counting sort passes, so duplicate edges end up next to each other.
+// 3. All nodes are laid out in one pool block, each vertex's list contiguous
+//    and ordered by neighbor index.
+// Throws the same exceptions as addEdge for invalid or duplicate edges.
+Graph::Graph(int vertices, const Edge* edges, int edgeCount)
+    : numVertices(vertices), adjacencyList(nullptr), visitOrder(nullptr), visitCount(0), edgeChecksum(0) {
+    if (vertices <= 0) {
+        throw invalid_argument("Number of vertices must be positive");
+    }
+    if (edgeCount < 0 || edgeCount > MAX_BULK_EDGES) {
+        throw invalid_argument("Invalid number of edges");
+    }
+    if (edges == nullptr && edgeCount > 0) {
+        throw invalid_argument("Edge array is null");
+    }
+
+    for (int i = 0; i < edgeCount; ++i) {
+        const Edge& e = edges[i];
+        if (e.from < 0 || e.from >= numVertices || e.to < 0 || e.to >= numVertices)
+            throw out_of_range("Invalid vertex index");
+        if (e.from == e.to)
+            throw invalid_argument("Cannot add self-loop");
+    }
+
+    // Directed entries: entry 2i is from -> to, entry 2i + 1 is to -> from
+    int entries = 2 * edgeCount;
+    int* source = new int[entries];
+    int* target = new int[entries];
+    for (int i = 0; i < edgeCount; ++i) {
+        source[2 * i] = edges[i].from;
+        target[2 * i] = edges[i].to;
+        source[2 * i + 1] = edges[i].to;
+        target[2 * i + 1] = edges[i].from;
+    }
+
+    int* order = new int[entries];
+    int* temp = new int[entries];
+    for (int i = 0; i < entries; ++i) {
+        temp[i] = i;
+    }
+    countingSortBy(target, numVertices, entries, temp, order);
+    countingSortBy(source, numVertices, entries, order, temp);
+    delete[] order;
+    order = temp;
+
+    for (int i = 1; i < entries; ++i) {
+        if (source[order[i]] == source[order[i - 1]] && target[order[i]] == target[order[i - 1]]) {
+            delete[] source;
+            delete[] target;
+            delete[] order;
+            throw invalid_argument("Edge already exists");
+        }
+    }
+
+    this->adjacencyList = new Node*[numVertices];
     for (int i = 0; i < numVertices; ++i) {
         adjacencyList[i] = nullptr;
-        Node* current = other.adjacencyList[i];
-        Node* last = nullptr;
-        while (current != nullptr) {
-            Node* newNode = new Node(current->vertex, current->weight);
-            if (last == nullptr) {
-                adjacencyList[i] = newNode;
-            } else {
-                last->next = newNode;
-            }
-            last = newNode;
-            current = current->next;
-        }
     }
+    this->visitOrder = new int[numVertices];
 
-    // Copy visitOrder
-    this->visitOrder = new int[this->numVertices];
-    for (int i = 0; i < other.visitCount; ++i) {
-        this->visitOrder[i] = other.visitOrder[i];
+    pool.reserve(entries);
+    edgeIndex.reserve(entries);
+    Node* last = nullptr;
+    for (int i = 0; i < entries; ++i) {
+        int u = source[order[i]];
+        int v = target[order[i]];
+        Node* node = pool.allocate(v, edges[order[i] / 2].weight, nullptr);
+        if (adjacencyList[u] == nullptr) {
+            adjacencyList[u] = node;
+        } else {
+            node->prev = last;
+            last->next = node;
+        }
+        last = node;
+        edgeIndex.insert(edgeKey(u, v), node);
+    }
+    for (int i = 0; i < edgeCount; ++i) {
+        edgeChecksum += edgeFingerprint(edges[i].from, edges[i].to, edges[i].weight);
     }
-    this->visitCount = other.visitCount;
+
+    delete[] source;
+    delete[] target;
+    delete[] order;
+}
+
+// Deep Copy Constructor
+Graph::Graph(const Graph& other) {
+    copyFrom(other);
 }
 
 // Assignment Operator (Rule of Three)
@@ -53,33 +226,95 @@ Graph& Graph::operator=(const Graph& other) {
     if (this == &other)
         return *this;
 
-    // Free old memory
-    for (int i = 0; i < numVertices; ++i) {
-        Node* current = adjacencyList[i];
-        while (current != nullptr) {
-            Node* temp = current;
-            current = current->next;
-            delete temp;
-        }
-    }
+    // Free old memory, all nodes are released with their blocks
+    pool.clear();
+    edgeIndex.clear();
     delete[] adjacencyList;
     delete[] visitOrder;
 
     // Copy new data
+    copyFrom(other);
+
+    return *this;
+}
+
+// Move Constructor
+// Takes over the adjacency lists, their nodes and visitOrder without copying.
+// The moved-from graph is left empty with zero vertices.
+Graph::Graph(Graph&& other) noexcept
+    : numVertices(other.numVertices), adjacencyList(other.adjacencyList), pool(std::move(other.pool)),
+      edgeIndex(std::move(other.edgeIndex)), visitOrder(other.visitOrder), visitCount(other.visitCount),
+      edgeChecksum(other.edgeChecksum) {
+    other.numVertices = 0;
+    other.adjacencyList = nullptr;
+    other.visitOrder = nullptr;
+    other.visitCount = 0;
+    other.edgeChecksum = 0;
+}
+
+// Move Assignment Operator
+Graph& Graph::operator=(Graph&& other) noexcept {
+    if (this == &other)
+        return *this;
+
+    // Free old memory, pool move assignment releases our nodes
+    delete[] adjacencyList;
+    delete[] visitOrder;
+
+    numVertices = other.numVertices;
+    adjacencyList = other.adjacencyList;
+    pool = std::move(other.pool);
+    edgeIndex = std::move(other.edgeIndex);
+    visitOrder = other.visitOrder;
+    visitCount = other.visitCount;
+    edgeChecksum = other.edgeChecksum;
+
+    other.numVertices = 0;
+    other.adjacencyList = nullptr;
+    other.visitOrder = nullptr;
+    other.visitCount = 0;
+    other.edgeChecksum = 0;
+
+    return *this;
+}
+
+// Destructor
+Graph::~Graph() {
+    // The adjacency nodes are freed in bulk by the pool destructor
+    delete[] this->adjacencyList;
+    delete[] this->visitOrder;
+}
+
+// Helper that copies the adjacency lists and visitOrder of other.
+// All nodes are counted first so they are copied into a single pool block.
+void Graph::copyFrom(const Graph& other) {
     numVertices = other.numVertices;
     adjacencyList = new Node*[numVertices];
+
+    int totalNodes = 0;
+    for (int i = 0; i < numVertices; ++i) {
+        for (Node* current = other.adjacencyList[i]; current != nullptr; current = current->next) {
+            ++totalNodes;
+        }
+    }
+    pool.reserve(totalNodes);
+    edgeIndex.reserve(totalNodes);
+
+    // Copy each adjacency list
     for (int i = 0; i < numVertices; ++i) {
         adjacencyList[i] = nullptr;
         Node* current = other.adjacencyList[i];
         Node* last = nullptr;
         while (current != nullptr) {
-            Node* newNode = new Node(current->vertex, current->weight);
+            Node* newNode = pool.allocate(current->vertex, current->weight, nullptr);
+            newNode->prev = last;
             if (last == nullptr) {
                 adjacencyList[i] = newNode;
             } else {
                 last->next = newNode;
             }
             last = newNode;
+            edgeIndex.insert(edgeKey(i, newNode->vertex), newNode);
             current = current->next;
         }
     }
@@ -90,30 +325,13 @@ Graph& Graph::operator=(const Graph& other) {
         visitOrder[i] = other.visitOrder[i];
     }
     visitCount = other.visitCount;
-
-    return *this;
-}
-
-// Destructor
-Graph::~Graph() {
-    // Free adjacency list memory
-    for (int i = 0; i < this->numVertices; ++i) {
-        Node* current = this->adjacencyList[i];
-        while (current != nullptr) {
-            Node* temp = current;
-            current = current->next;
-            delete temp;
-        }
-    }
-
-    // Free additional arrays
-    delete[] this->adjacencyList;
-    delete[] this->visitOrder;
+    edgeChecksum = other.edgeChecksum;
 }
 
 // Add an edge to the graph
 // If the edge already exists, throw an exception
 // If the edge is a self-loop, throw an exception
+// Duplicate detection is an O(1) expected lookup in edgeIndex
 
 void Graph::addEdge(int from, int to, int weight) {
     if (from < 0 || from >= this->numVertices || to < 0 || to >= this->numVertices)
@@ -124,16 +342,13 @@ void Graph::addEdge(int from, int to, int weight) {
     }
     
     // Check if the edge already exists
-    Node* current = this->adjacencyList[from];
-    while (current != nullptr) {
-        if (current->vertex == to) {
-            throw invalid_argument("Edge already exists");
-        }
-        current = current->next;
+    if (edgeIndex.find(edgeKey(from, to)) != nullptr) {
+        throw invalid_argument("Edge already exists");
     }
     // Add the edge to the adjacency list
-    this->adjacencyList[from] = new Node(to, weight, this->adjacencyList[from]);
-    this->adjacencyList[to] = new Node(from, weight, this->adjacencyList[to]); // undirected
+    pushFront(from, to, weight);
+    pushFront(to, from, weight); // undirected
+    edgeChecksum += edgeFingerprint(from, to, weight);
 }
 
 // Remove an edge from the graph
@@ -147,33 +362,43 @@ void Graph::removeEdge(int from, int to) {
     if (from == to) {
         throw invalid_argument("Cannot remove self-loop");
     }
-    if (adjacencyList[from] == nullptr || adjacencyList[to] == nullptr) {
+    Node* forward = edgeIndex.find(edgeKey(from, to));
+    Node* backward = edgeIndex.find(edgeKey(to, from));
+    if (forward == nullptr || backward == nullptr) {
         throw invalid_argument("Edge does not exist");
     }
     // Remove the edge from both vertices
-    removeEdgeFromList(from, to); // removes to from from's list
-    removeEdgeFromList(to, from); // and vice versa
-}
-
-// Helper function to remove an edge from the adjacency list
-void Graph::removeEdgeFromList(int from, int to) {
-    Node* prev = nullptr;
-    Node* curr = adjacencyList[from];
-
-    while (curr != nullptr) {
-        if (curr->vertex == to) {
-            if (prev == nullptr)
-                adjacencyList[from] = curr->next;
-            else
-                prev->next = curr->next;
-            delete curr;
-            return;
-        }
-        prev = curr;
-        curr = curr->next;
-    }
+    edgeChecksum -= edgeFingerprint(from, to, forward->weight);
+    edgeIndex.erase(edgeKey(from, to));
+    edgeIndex.erase(edgeKey(to, from));
+    unlinkNode(from, forward); // removes to from from's list
+    unlinkNode(to, backward); // and vice versa
+}
+
+// Key of the directed adjacency entry (from, to) in edgeIndex
+long long Graph::edgeKey(int from, int to) const {
+    return static_cast<long long>(from) * numVertices + to;
+}
+
+// Helper function to insert to at the front of from's list and index it
+void Graph::pushFront(int from, int to, int weight) {
+    Node* head = adjacencyList[from];
+    Node* node = pool.allocate(to, weight, head);
+    if (head != nullptr)
+        head->prev = node;
+    adjacencyList[from] = node;
+    edgeIndex.insert(edgeKey(from, to), node);
+}
 
-    throw invalid_argument("Edge does not exist");
+// Helper function to unlink a node from from's list in O(1)
+void Graph::unlinkNode(int from, Node* node) {
+    if (node->prev == nullptr)
+        adjacencyList[from] = node->next;
+    else
+        node->prev->next = node->next;
+    if (node->next != nullptr)
+        node->next->prev = node->prev;
+    pool.release(node);
 }
 
 // Print the graph in a readable format
@@ -216,4 +441,11 @@ Node* Graph::getAdjList(int v) const {
     return adjacencyList[v];
 }
 
+// Find the adjacency entry of the edge from - to through the edge index
+Node* Graph::findEdge(int from, int to) const {
+    if (from < 0 || from >= numVertices || to < 0 || to >= numVertices)
+        throw out_of_range("Invalid vertex index");
+    return edgeIndex.find(edgeKey(from, to));
+}
+
 } // namespace graph
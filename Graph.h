@@ -4,6 +4,7 @@
 #define GRAPH_H
 
 #include <iostream>
+#include "DataStructures.h"
 using namespace std;
 
 namespace graph {
@@ -11,25 +12,85 @@ namespace graph {
 struct Node {
     int vertex;
     int weight;
-    // Pointer to the next node in the adjacency list
+    // Pointers to the next and previous nodes in the adjacency list
     Node* next;
+    Node* prev;
     
 
-    Node(int d, int w, Node* n = nullptr)
-        : vertex(d), weight(w), next(n) {}
+    Node(int d, int w, Node* n = nullptr, Node* p = nullptr)
+        : vertex(d), weight(w), next(n), prev(p) {}
+};
+
+// One undirected edge, used for bulk construction
+struct Edge {
+    int from;
+    int to;
+    int weight;
+};
+
+// Fingerprint of one undirected edge, the same for (u, v) and (v, u).
+// A graph's edge checksum is the sum of the fingerprints of its edges, so it does
+// not depend on the order of the adjacency lists and is kept up to date one edge at
+// a time. Landmark tables record it to detect a graph that changed since.
+inline unsigned long long edgeFingerprint(int u, int v, int weight) {
+    unsigned long long lo = static_cast<unsigned int>(u < v ? u : v);
+    unsigned long long hi = static_cast<unsigned int>(u < v ? v : u);
+    unsigned long long x = (lo << 32 | hi) ^ (static_cast<unsigned long long>(static_cast<unsigned int>(weight)) * 0x9E3779B97F4A7C15ULL);
+    // splitmix64 finalizer
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+// Slab allocator for the adjacency nodes of one Graph.
+// Nodes are carved out of large blocks, nodes released by removeEdge
+// are kept on a free list for reuse, and all blocks are freed together.
+class NodePool {
+private:
+    struct Block {
+        Node* nodes;
+        int capacity;
+        int used;
+        Block* next;
+    };
+
+    Block* blocks;   // Most recent block first
+    Node* freeList;  // Released nodes, linked through Node::next
+    int nextBlockSize;
+
+    void addBlock(int capacity);
+
+public:
+    NodePool();
+    ~NodePool();
+    NodePool(const NodePool&) = delete;
+    NodePool& operator=(const NodePool&) = delete;
+    NodePool(NodePool&& other) noexcept; // Takes over all blocks of other
+    NodePool& operator=(NodePool&& other) noexcept;
+
+    Node* allocate(int vertex, int weight, Node* next);
+    void release(Node* node);
+    void reserve(int count); // Make room for count nodes in a single block
+    void clear();            // Free every block at once
 };
 
 class Graph {
 private:
     int numVertices;
     Node** adjacencyList;
+    NodePool pool; // Owns every Node in adjacencyList
+    EdgeMap edgeIndex; // (from, to) -> node of to in from's list
     int* visitOrder; // Array to store the order of visits for DFS/BFS
     int visitCount; 
+    unsigned long long edgeChecksum; // Sum of edgeFingerprint over all edges
 
 public:
     Graph(int vertices);
+    Graph(int vertices, const Edge* edges, int edgeCount); // Bulk construction from an edge array
     Graph(const Graph& other); // Deep copy constructor
     Graph& operator=(const Graph& other); // Assignment operator
+    Graph(Graph&& other) noexcept; // Move constructor, steals the adjacency lists
+    Graph& operator=(Graph&& other) noexcept; // Move assignment
     ~Graph();
 
 
@@ -38,7 +99,10 @@ public:
     void print_graph() const;
 
     int getNumVertices() const;
+    int getNumEntries() const { return edgeIndex.getSize(); } // Adjacency entries, twice the edge count
     Node* getAdjList(int v) const;
+    Node* findEdge(int from, int to) const; // Entry of to in from's list in O(1), nullptr if absent
+    unsigned long long getEdgeChecksum() const { return edgeChecksum; }
 
     void initializeVisitOrder(); // Initialize visitOrder array
     void setVisitOrder(int index, int vertex);
@@ -50,7 +114,10 @@ public:
     
 
 private:
-    void removeEdgeFromList(int from, int to);
+    long long edgeKey(int from, int to) const;
+    void pushFront(int from, int to, int weight);
+    void unlinkNode(int from, Node* node);
+    void copyFrom(const Graph& other);
 };
 
 } // namespace graph
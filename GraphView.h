@@ -0,0 +1,70 @@
+// email:shmuel.benatar@msmail.ariel.ac.il
+#ifndef GRAPHVIEW_H
+#define GRAPHVIEW_H
+
+#include "Graph.h"
+#include "CSRGraph.h"
+
+namespace graph {
+
+// Every algorithm is written once against an adjacency "view" so that it
+// runs on both the linked-list Graph and the frozen CSRGraph.
+// A view exposes numVertices() and a cursor over the neighbors of a vertex:
+//   Cursor c = view.first(u); view.valid(c); view.advance(c);
+//   view.target(c); view.weight(c);
+// plus degree(u) and numEntries(), the total number of adjacency entries.
+// constantDegree tells whether degree(u) is O(1) or walks the neighbors.
+
+// View over the linked-list adjacency of a Graph
+struct ListView {
+    const Graph& g;
+
+    struct Cursor {
+        const Node* node;
+    };
+
+    static const bool constantDegree = false;
+
+    explicit ListView(const Graph& graph) : g(graph) {}
+
+    int numVertices() const { return g.getNumVertices(); }
+    long long numEntries() const { return g.getNumEntries(); }
+    int degree(int u) const {
+        int count = 0;
+        for (const Node* p = g.getAdjList(u); p != nullptr; p = p->next)
+            ++count;
+        return count;
+    }
+    Cursor first(int u) const { return Cursor{g.getAdjList(u)}; }
+    bool valid(const Cursor& c) const { return c.node != nullptr; }
+    void advance(Cursor& c) const { c.node = c.node->next; }
+    int target(const Cursor& c) const { return c.node->vertex; }
+    int weight(const Cursor& c) const { return c.node->weight; }
+};
+
+// View over the contiguous rows of a CSRGraph
+struct CSRView {
+    const CSRGraph& g;
+
+    struct Cursor {
+        int pos;
+        int end;
+    };
+
+    static const bool constantDegree = true;
+
+    explicit CSRView(const CSRGraph& graph) : g(graph) {}
+
+    int numVertices() const { return g.getNumVertices(); }
+    long long numEntries() const { return g.getNumEntries(); }
+    int degree(int u) const { return g.getOffset(u + 1) - g.getOffset(u); }
+    Cursor first(int u) const { return Cursor{g.getOffset(u), g.getOffset(u + 1)}; }
+    bool valid(const Cursor& c) const { return c.pos < c.end; }
+    void advance(Cursor& c) const { ++c.pos; }
+    int target(const Cursor& c) const { return g.getNeighbor(c.pos); }
+    int weight(const Cursor& c) const { return g.getWeight(c.pos); }
+};
+
+} // namespace graph
+
+#endif
@@ -0,0 +1,374 @@
+// email:shmuel.benatar@msmail.ariel.ac.il
+#include "Landmarks.h"
+#include "Algorithms.h"
+#include "Parallel.h"
+#include <stdexcept>
+#include <fstream>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace graph {
+
+// File header, see Landmarks.h for the layout
+struct LandmarkHeader {
+    char magic[8];
+    unsigned int version;
+    unsigned int byteOrder;
+    long long numVertices;
+    long long numLandmarks;
+    long long graphEntries;
+    unsigned long long graphChecksum;
+};
+
+static const char LANDMARK_MAGIC[8] = {'L', 'A', 'N', 'D', 'M', 'A', 'R', 'K'};
+static const unsigned int LANDMARK_VERSION = 2;
+static const unsigned int LANDMARK_BYTE_ORDER = 0x01020304;
+
+const int LandmarkTable::UNREACHED;
+
+// Farthest-Point Constructors
+LandmarkTable::LandmarkTable(const Graph& g, int count, int numThreads)
+    : numVertices(0), numLandmarks(0), landmarks(nullptr), distances(nullptr), mapping(nullptr), mappingSize(0), graphEntries(0), graphChecksum(0) {
+    selectFarthest(g, count);
+    build(g, numThreads);
+}
+
+LandmarkTable::LandmarkTable(const CSRGraph& g, int count, int numThreads)
+    : numVertices(0), numLandmarks(0), landmarks(nullptr), distances(nullptr), mapping(nullptr), mappingSize(0), graphEntries(0), graphChecksum(0) {
+    selectFarthest(g, count);
+    build(g, numThreads);
+}
+
+// Given-Landmark Constructors
+LandmarkTable::LandmarkTable(const Graph& g, const int* chosen, int count, int numThreads)
+    : numVertices(0), numLandmarks(0), landmarks(nullptr), distances(nullptr), mapping(nullptr), mappingSize(0), graphEntries(0), graphChecksum(0) {
+    allocate(g.getNumVertices(), count);
+    for (int i = 0; i < count; ++i) {
+        if (chosen[i] < 0 || chosen[i] >= numVertices) {
+            release();
+            throw out_of_range("Landmark " + to_string(chosen[i]) + " is out of bounds");
+        }
+        landmarks[i] = chosen[i];
+    }
+    build(g, numThreads);
+}
+
+LandmarkTable::LandmarkTable(const CSRGraph& g, const int* chosen, int count, int numThreads)
+    : numVertices(0), numLandmarks(0), landmarks(nullptr), distances(nullptr), mapping(nullptr), mappingSize(0), graphEntries(0), graphChecksum(0) {
+    allocate(g.getNumVertices(), count);
+    for (int i = 0; i < count; ++i) {
+        if (chosen[i] < 0 || chosen[i] >= numVertices) {
+            release();
+            throw out_of_range("Landmark " + to_string(chosen[i]) + " is out of bounds");
+        }
+        landmarks[i] = chosen[i];
+    }
+    build(g, numThreads);
+}
+
+// Farthest-point selection on BFS hops, which is cheap next to the Dijkstra runs.
+// hops[v] is the fewest hops from v to a chosen landmark (UNREACHED if none
+// reaches it), seeded with a BFS from vertex 0. Each round picks the vertex with
+// the largest hops (the lowest such index), so unreached components come first.
+template <class GraphType>
+void LandmarkTable::selectFarthest(const GraphType& g, int count) {
+    if (count > g.getNumVertices()) {
+        throw invalid_argument("More landmarks than vertices");
+    }
+    allocate(g.getNumVertices(), count);
+
+    int* hops = new int[numVertices];
+    TraversalResult search;
+    Algorithms::bfs(g, 0, search);
+    for (int v = 0; v < numVertices; ++v) {
+        hops[v] = search.distance[v] == -1 ? UNREACHED : search.distance[v];
+    }
+
+    for (int i = 0; i < count; ++i) {
+        int farthest = 0;
+        for (int v = 1; v < numVertices; ++v) {
+            if (hops[v] > hops[farthest])
+                farthest = v;
+        }
+        landmarks[i] = farthest;
+
+        Algorithms::bfs(g, farthest, search);
+        for (int v = 0; v < numVertices; ++v) {
+            if (search.distance[v] != -1 && search.distance[v] < hops[v])
+                hops[v] = search.distance[v];
+        }
+    }
+    delete[] hops;
+}
+
+// True if any edge of g has a negative weight
+static bool hasNegativeWeight(const Graph& g) {
+    for (int u = 0; u < g.getNumVertices(); ++u) {
+        for (Node* curr = g.getAdjList(u); curr != nullptr; curr = curr->next) {
+            if (curr->weight < 0)
+                return true;
+        }
+    }
+    return false;
+}
+
+static bool hasNegativeWeight(const CSRGraph& g) {
+    for (int i = 0; i < g.getNumEntries(); ++i) {
+        if (g.getWeight(i) < 0)
+            return true;
+    }
+    return false;
+}
+
+// Runs Dijkstra from every landmark, landmarks split across threads. Each run
+// writes its own contiguous row of a landmark-major scratch table; the rows are
+// then transposed into the vertex-major table, vertices split across threads,
+// so no two threads ever write the same cache line.
+// Negative weights are rejected before any thread starts. Called last by the
+// constructors, so on any failure it frees the table's arrays before rethrowing.
+template <class GraphType>
+void LandmarkTable::build(const GraphType& g, int numThreads) {
+    if (hasNegativeWeight(g)) {
+        release();
+        throw invalid_argument("Negative edge weight detected. Landmark distances need non-negative weights.");
+    }
+    graphEntries = g.getNumEntries();
+    graphChecksum = g.getEdgeChecksum();
+    numThreads = resolveThreadCount(numThreads);
+    int* rows = nullptr;
+    try {
+        rows = new int[static_cast<long long>(numLandmarks) * numVertices];
+        parallelChunks(numLandmarks, numThreads, [&](int, int begin, int end) {
+            TraversalResult result;
+            for (int i = begin; i < end; ++i) {
+                Algorithms::dijkstra(g, landmarks[i], result);
+                int* row = rows + static_cast<long long>(i) * numVertices;
+                for (int v = 0; v < numVertices; ++v) {
+                    row[v] = result.distance[v]; // INT_MAX when unreached, the same as UNREACHED
+                }
+            }
+        });
+    } catch (...) {
+        delete[] rows;
+        release();
+        throw;
+    }
+
+    parallelChunks(numVertices, numThreads, [&](int, int begin, int end) {
+        for (int v = begin; v < end; ++v) {
+            for (int i = 0; i < numLandmarks; ++i) {
+                distances[static_cast<long long>(v) * numLandmarks + i] = rows[static_cast<long long>(i) * numVertices + v];
+            }
+        }
+    });
+    delete[] rows;
+}
+
+// Helper that allocates owned arrays for count landmarks
+void LandmarkTable::allocate(int vertices, int count) {
+    if (count <= 0) {
+        throw invalid_argument("Number of landmarks must be positive");
+    }
+    numVertices = vertices;
+    numLandmarks = count;
+    landmarks = new int[count];
+    distances = new int[static_cast<long long>(vertices) * count];
+}
+
+// File Constructor
+// Maps the file read-only and points the arrays into it. Besides the header and
+// the size, one pass checks the landmark ids, that each landmark is at distance
+// 0 from itself and that no distance is negative. Whether the table belongs to
+// a graph is checked by matches() against the recorded entry count and checksum.
+LandmarkTable::LandmarkTable(const std::string& path)
+    : numVertices(0), numLandmarks(0), landmarks(nullptr), distances(nullptr), mapping(nullptr), mappingSize(0), graphEntries(0), graphChecksum(0) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw runtime_error("Cannot open landmark table " + path);
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(LandmarkHeader))) {
+        close(fd);
+        throw runtime_error("Invalid landmark table " + path);
+    }
+    size_t size = static_cast<size_t>(info.st_size);
+    void* data = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd); // The mapping stays valid after the descriptor is closed
+    if (data == MAP_FAILED) {
+        throw runtime_error("Cannot map landmark table " + path);
+    }
+
+    const LandmarkHeader* header = static_cast<const LandmarkHeader*>(data);
+    bool valid = memcmp(header->magic, LANDMARK_MAGIC, sizeof(LANDMARK_MAGIC)) == 0 &&
+                 header->version == LANDMARK_VERSION && header->byteOrder == LANDMARK_BYTE_ORDER &&
+                 header->numVertices > 0 && header->numVertices < 2147483647LL &&
+                 header->numLandmarks > 0 && header->numLandmarks <= header->numVertices &&
+                 header->graphEntries >= 0 && header->graphEntries <= 2147483647LL;
+    if (valid) {
+        long long expected = static_cast<long long>(sizeof(LandmarkHeader)) +
+                             4LL * header->numLandmarks * (1 + header->numVertices);
+        valid = expected == static_cast<long long>(size);
+    }
+    if (!valid) {
+        munmap(data, size);
+        throw runtime_error("Invalid landmark table " + path);
+    }
+
+    // The mapping is read-only, the arrays are only ever read through const members
+    int* base = reinterpret_cast<int*>(static_cast<char*>(data) + sizeof(LandmarkHeader));
+    numVertices = static_cast<int>(header->numVertices);
+    numLandmarks = static_cast<int>(header->numLandmarks);
+    graphEntries = static_cast<int>(header->graphEntries);
+    graphChecksum = header->graphChecksum;
+    landmarks = base;
+    distances = base + numLandmarks;
+
+    // Every landmark is a vertex at distance 0 from itself, and no distance is negative
+    for (int i = 0; valid && i < numLandmarks; ++i) {
+        valid = landmarks[i] >= 0 && landmarks[i] < numVertices && getDistance(i, landmarks[i]) == 0;
+    }
+    long long total = static_cast<long long>(numVertices) * numLandmarks;
+    for (long long i = 0; valid && i < total; ++i) {
+        valid = distances[i] >= 0;
+    }
+    if (!valid) {
+        munmap(data, size);
+        throw runtime_error("Invalid landmark table " + path);
+    }
+    mapping = data;
+    mappingSize = size;
+}
+
+// Write the header and both arrays in the file layout
+void LandmarkTable::save(const std::string& path) const {
+    ofstream out(path, ios::binary | ios::trunc);
+    if (!out) {
+        throw runtime_error("Cannot create landmark table " + path);
+    }
+
+    LandmarkHeader header;
+    memcpy(header.magic, LANDMARK_MAGIC, sizeof(LANDMARK_MAGIC));
+    header.version = LANDMARK_VERSION;
+    header.byteOrder = LANDMARK_BYTE_ORDER;
+    header.numVertices = numVertices;
+    header.numLandmarks = numLandmarks;
+    header.graphEntries = graphEntries;
+    header.graphChecksum = graphChecksum;
+
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(landmarks), sizeof(int) * static_cast<size_t>(numLandmarks));
+    out.write(reinterpret_cast<const char*>(distances),
+              sizeof(int) * static_cast<size_t>(numLandmarks) * static_cast<size_t>(numVertices));
+    out.close();
+    if (!out) {
+        throw runtime_error("Cannot write landmark table " + path);
+    }
+}
+
+// Deep Copy Constructor
+// Copying a mapped table produces an ordinary table that owns its arrays
+LandmarkTable::LandmarkTable(const LandmarkTable& other) {
+    copyFrom(other);
+}
+
+// Assignment Operator
+LandmarkTable& LandmarkTable::operator=(const LandmarkTable& other) {
+    if (this == &other)
+        return *this;
+
+    release();
+    copyFrom(other);
+
+    return *this;
+}
+
+// Move Constructor
+// Takes over the owned arrays, or the file mapping of a mapped table, without
+// copying. The moved-from table is left empty with zero vertices and landmarks.
+LandmarkTable::LandmarkTable(LandmarkTable&& other) noexcept
+    : numVertices(other.numVertices), numLandmarks(other.numLandmarks), landmarks(other.landmarks),
+      distances(other.distances), mapping(other.mapping), mappingSize(other.mappingSize),
+      graphEntries(other.graphEntries), graphChecksum(other.graphChecksum) {
+    other.numVertices = 0;
+    other.numLandmarks = 0;
+    other.landmarks = nullptr;
+    other.distances = nullptr;
+    other.mapping = nullptr;
+    other.mappingSize = 0;
+    other.graphEntries = 0;
+    other.graphChecksum = 0;
+}
+
+// Move Assignment Operator
+LandmarkTable& LandmarkTable::operator=(LandmarkTable&& other) noexcept {
+    if (this == &other)
+        return *this;
+
+    release();
+    numVertices = other.numVertices;
+    numLandmarks = other.numLandmarks;
+    landmarks = other.landmarks;
+    distances = other.distances;
+    mapping = other.mapping;
+    mappingSize = other.mappingSize;
+    graphEntries = other.graphEntries;
+    graphChecksum = other.graphChecksum;
+
+    other.numVertices = 0;
+    other.numLandmarks = 0;
+    other.landmarks = nullptr;
+    other.distances = nullptr;
+    other.mapping = nullptr;
+    other.mappingSize = 0;
+    other.graphEntries = 0;
+    other.graphChecksum = 0;
+
+    return *this;
+}
+
+// Destructor
+LandmarkTable::~LandmarkTable() {
+    release();
+}
+
+// Helper that frees owned arrays or unmaps the file
+void LandmarkTable::release() {
+    if (mapping != nullptr) {
+        munmap(mapping, mappingSize);
+        mapping = nullptr;
+        mappingSize = 0;
+    } else {
+        delete[] landmarks;
+        delete[] distances;
+    }
+    landmarks = nullptr;
+    distances = nullptr;
+}
+
+// Helper that allocates and copies both arrays of other
+void LandmarkTable::copyFrom(const LandmarkTable& other) {
+    mapping = nullptr;
+    mappingSize = 0;
+    graphEntries = other.graphEntries;
+    graphChecksum = other.graphChecksum;
+    if (other.numLandmarks == 0) { // A moved-from table
+        numVertices = 0;
+        numLandmarks = 0;
+        landmarks = nullptr;
+        distances = nullptr;
+        return;
+    }
+    allocate(other.numVertices, other.numLandmarks);
+    for (int i = 0; i < numLandmarks; ++i) {
+        landmarks[i] = other.landmarks[i];
+    }
+    long long total = static_cast<long long>(numVertices) * numLandmarks;
+    for (long long i = 0; i < total; ++i) {
+        distances[i] = other.distances[i];
+    }
+}
+
+} // namespace graph
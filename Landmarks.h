@@ -0,0 +1,117 @@
+// email:shmuel.benatar@msmail.ariel.ac.il
+#ifndef LANDMARKS_H
+#define LANDMARKS_H
+
+#include "Graph.h"
+#include "CSRGraph.h"
+#include <string>
+#include <cstddef>
+
+namespace graph {
+
+// Shortest path distances from k landmark vertices to every vertex, for ALT
+// (A*, landmarks, triangle inequality) queries. For every landmark L and
+// vertices v, t of an undirected graph, dist(v, t) >= |dist(L, t) - dist(L, v)|,
+// so the best landmark gives an admissible A* heuristic (see LandmarkHeuristic).
+//
+// Landmarks are either given or picked by farthest-point selection: each next
+// landmark is the vertex with the most BFS hops to the landmarks chosen so far,
+// which spreads them over the edges of the graph (and into every component).
+// The Dijkstra runs of the landmarks are spread across worker threads.
+//
+// The table is vertex-major, distances[v * k + i] for landmark i, so a bound
+// reads two short contiguous rows. UNREACHED marks a vertex a landmark cannot reach.
+//
+// A table remembers the adjacency entry count and edge checksum of the graph it
+// was built from, and matches() compares them in O(1). aStar refuses a table
+// built for a different or since edited graph, whose bounds could overestimate.
+//
+// A table can be saved next to its graph and opened again with mmap.
+// File layout (native byte order):
+//   header:    8-byte magic "LANDMARK", uint32 version, uint32 byte order mark,
+//              int64 numVertices, int64 numLandmarks, int64 graphEntries,
+//              uint64 graphChecksum (48 bytes)
+//   landmarks: numLandmarks int32
+//   distances: numVertices * numLandmarks int32
+class LandmarkTable {
+public:
+    static const int UNREACHED = 2147483647;
+
+private:
+    int numVertices;
+    int numLandmarks;
+    int* landmarks;
+    int* distances;
+    void* mapping; // File mapping the arrays point into, nullptr if they are owned
+    size_t mappingSize;
+    int graphEntries; // Adjacency entries of the graph the table was built from
+    unsigned long long graphChecksum; // Its edge checksum
+
+public:
+    // count landmarks by farthest-point selection, numThreads 0 uses the hardware concurrency
+    LandmarkTable(const Graph& g, int count, int numThreads = 0);
+    LandmarkTable(const CSRGraph& g, int count, int numThreads = 0);
+    // The count given landmarks
+    LandmarkTable(const Graph& g, const int* chosen, int count, int numThreads = 0);
+    LandmarkTable(const CSRGraph& g, const int* chosen, int count, int numThreads = 0);
+    explicit LandmarkTable(const std::string& path); // Map a saved table read-only
+    LandmarkTable(const LandmarkTable& other); // Deep copy constructor
+    LandmarkTable& operator=(const LandmarkTable& other); // Assignment operator
+    LandmarkTable(LandmarkTable&& other) noexcept; // Move constructor, takes the arrays or the mapping
+    LandmarkTable& operator=(LandmarkTable&& other) noexcept; // Move assignment
+    ~LandmarkTable();
+
+    int getNumVertices() const { return numVertices; }
+    int getNumLandmarks() const { return numLandmarks; }
+    int getLandmark(int i) const { return landmarks[i]; }
+    int getDistance(int i, int v) const { return distances[static_cast<long long>(v) * numLandmarks + i]; }
+    bool isMapped() const { return mapping != nullptr; }
+
+    // True if g has the size, entry count and edge checksum of the graph the table was built from
+    bool matches(const Graph& g) const {
+        return g.getNumVertices() == numVertices && g.getNumEntries() == graphEntries && g.getEdgeChecksum() == graphChecksum;
+    }
+    bool matches(const CSRGraph& g) const {
+        return g.getNumVertices() == numVertices && g.getNumEntries() == graphEntries && g.getEdgeChecksum() == graphChecksum;
+    }
+
+    // Largest landmark lower bound on the distance between v and t, no range checks
+    int lowerBound(int v, int t) const {
+        const int* fromV = distances + static_cast<long long>(v) * numLandmarks;
+        const int* fromT = distances + static_cast<long long>(t) * numLandmarks;
+        int best = 0;
+        for (int i = 0; i < numLandmarks; ++i) {
+            if (fromV[i] == UNREACHED || fromT[i] == UNREACHED)
+                continue;
+            int bound = fromT[i] > fromV[i] ? fromT[i] - fromV[i] : fromV[i] - fromT[i];
+            if (bound > best)
+                best = bound;
+        }
+        return best;
+    }
+
+    void save(const std::string& path) const; // Write the table to a file
+
+private:
+    template <class GraphType>
+    void selectFarthest(const GraphType& g, int count);
+    template <class GraphType>
+    void build(const GraphType& g, int numThreads);
+    void allocate(int vertices, int count);
+    void copyFrom(const LandmarkTable& other);
+    void release();
+};
+
+// A* heuristic from a LandmarkTable: the landmark lower bound on the distance to target
+struct LandmarkHeuristic {
+    const LandmarkTable& table;
+    int target;
+
+    LandmarkHeuristic(const LandmarkTable& landmarks, int goal) : table(landmarks), target(goal) {}
+
+    int operator()(int v) const { return table.lowerBound(v, target); }
+};
+
+} // namespace graph
+
+#endif
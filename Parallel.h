@@ -0,0 +1,182 @@
+// email:shmuel.benatar@msmail.ariel.ac.il
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <stdexcept>
+
+namespace graph {
+
+// Number of worker threads to use: requested when positive,
+// otherwise the hardware concurrency (at least 1)
+inline int resolveThreadCount(int requested) {
+    if (requested > 0)
+        return requested;
+    unsigned int hardware = std::thread::hardware_concurrency();
+    return hardware > 0 ? static_cast<int>(hardware) : 1;
+}
+
+// Start of chunk t when [0, count) is split into numThreads contiguous chunks,
+// chunk t is [chunkBegin(count, t, numThreads), chunkBegin(count, t + 1, numThreads))
+inline int chunkBegin(int count, int t, int numThreads) {
+    return static_cast<int>(static_cast<long long>(count) * t / numThreads);
+}
+
+// First exception thrown by any thread of a group, kept to be rethrown on the
+// calling thread once all of them are joined (an exception leaving a std::thread
+// would terminate the process)
+class FirstException {
+private:
+    std::mutex lock;
+    std::exception_ptr error;
+
+public:
+    void capture() {
+        std::lock_guard<std::mutex> guard(lock);
+        if (!error)
+            error = std::current_exception();
+    }
+
+    void rethrow() {
+        if (error)
+            std::rethrow_exception(error);
+    }
+};
+
+// Split [0, count) into numThreads contiguous chunks and run
+// body(thread, begin, end) on each, one thread per chunk.
+// The calling thread runs chunk 0 and waits for the others.
+// Chunk boundaries depend only on count and numThreads, so two calls with
+// the same arguments give every thread the same range.
+// If any chunk throws, every thread is still joined and the first exception
+// is rethrown on the calling thread.
+template <class Body>
+void parallelChunks(int count, int numThreads, Body body) {
+    if (numThreads > count)
+        numThreads = count > 0 ? count : 1;
+    if (numThreads <= 1) {
+        body(0, 0, count);
+        return;
+    }
+
+    FirstException failure;
+    auto run = [&](int t, int begin, int end) {
+        try {
+            body(t, begin, end);
+        } catch (...) {
+            failure.capture();
+        }
+    };
+    std::thread* workers = new std::thread[numThreads - 1];
+    int started = 0;
+    try {
+        for (; started < numThreads - 1; ++started) {
+            int t = started + 1;
+            int begin = chunkBegin(count, t, numThreads);
+            int end = chunkBegin(count, t + 1, numThreads);
+            workers[started] = std::thread([=, &run]() { run(t, begin, end); });
+        }
+    } catch (...) {
+        failure.capture(); // A thread could not be started, the call fails as a whole
+    }
+    if (started == numThreads - 1)
+        run(0, 0, chunkBegin(count, 1, numThreads));
+    for (int t = 0; t < started; ++t) {
+        workers[t].join();
+    }
+    delete[] workers;
+    failure.rethrow();
+}
+
+// Reusable barrier for a fixed number of threads: wait() returns once all of
+// them have called it, and everything a thread wrote before its wait() is
+// visible to every thread after theirs. Waiting threads sleep on a condition
+// variable instead of spinning, so more threads than cores stay cheap.
+class Barrier {
+private:
+    std::mutex lock;
+    std::condition_variable released;
+    int numThreads;
+    int waiting;
+    unsigned long long generation; // Number of completed rounds
+    bool cancelled;
+
+public:
+    explicit Barrier(int threads) : numThreads(threads), waiting(0), generation(0), cancelled(false) {}
+    Barrier(const Barrier&) = delete;
+    Barrier& operator=(const Barrier&) = delete;
+
+    // Throws std::runtime_error once the barrier is cancelled
+    void wait() {
+        std::unique_lock<std::mutex> guard(lock);
+        if (cancelled)
+            throw std::runtime_error("Barrier cancelled");
+        unsigned long long round = generation;
+        if (++waiting == numThreads) {
+            waiting = 0;
+            ++generation;
+            released.notify_all();
+            return;
+        }
+        released.wait(guard, [&]() { return generation != round || cancelled; });
+        if (generation == round)
+            throw std::runtime_error("Barrier cancelled");
+    }
+
+    // Releases every waiting thread with an exception, a thread that failed
+    // calls this so the others do not wait for it forever
+    void cancel() {
+        std::lock_guard<std::mutex> guard(lock);
+        cancelled = true;
+        released.notify_all();
+    }
+};
+
+// Run body(thread) on numThreads threads at once, the calling thread being
+// thread 0, and wait for all of them. Unlike parallelChunks the threads live
+// for the whole call, so one team can run many rounds of a search separated
+// by waits on barrier, which must be set up for numThreads threads.
+// If a thread throws, the barrier is cancelled so the others leave their
+// waits, every thread is joined and the first exception is rethrown.
+template <class Body>
+void parallelTeam(int numThreads, Barrier& barrier, Body body) {
+    if (numThreads <= 1) {
+        body(0);
+        return;
+    }
+
+    FirstException failure;
+    auto run = [&](int t) {
+        try {
+            body(t);
+        } catch (...) {
+            failure.capture();
+            barrier.cancel();
+        }
+    };
+    std::thread* workers = new std::thread[numThreads - 1];
+    int started = 0;
+    try {
+        for (; started < numThreads - 1; ++started) {
+            int t = started + 1;
+            workers[started] = std::thread([=, &run]() { run(t); });
+        }
+    } catch (...) {
+        failure.capture();
+        barrier.cancel(); // The started threads would wait for the missing ones
+    }
+    if (started == numThreads - 1)
+        run(0);
+    for (int t = 0; t < started; ++t) {
+        workers[t].join();
+    }
+    delete[] workers;
+    failure.rethrow();
+}
+
+} // namespace graph
+
+#endif
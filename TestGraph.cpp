@@ -2,9 +2,14 @@
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 
 #include "Graph.h"
+#include "CSRGraph.h"
 #include "Algorithms.h"
 #include "DataStructures.h"
+#include "Parallel.h"
 #include "doctest.h"
+#include <thread>
+#include <atomic>
+#include <fstream>
 using namespace graph;
 
 TEST_CASE("Kruskal Test - Check total weight") {
@@ -167,6 +172,44 @@ TEST_CASE("Union Find Find Returns Correct Root") {
     CHECK(uf.find(0) != uf.find(2));
 }
 
+TEST_CASE("Union Find Set Sizes And Count") {
+    UnionFind uf(6);
+    CHECK(uf.numSets() == 6);
+    CHECK(uf.unite(0, 1));
+    CHECK(uf.unite(2, 3));
+    CHECK(uf.unite(3, 4));
+    CHECK(!uf.unite(2, 4));
+    CHECK(uf.numSets() == 3);
+    CHECK(uf.setSize(1) == 2);
+    CHECK(uf.setSize(4) == 3);
+    CHECK(uf.setSize(5) == 1);
+    CHECK(uf.unite(1, 2));
+    CHECK(uf.setSize(0) == 5);
+    CHECK(uf.numSets() == 2);
+    CHECK_THROWS_AS(uf.find(6), std::out_of_range);
+    CHECK_THROWS_AS(UnionFind(0), std::invalid_argument);
+}
+
+TEST_CASE("Union Find Balanced Merges Of A Million Elements") {
+    // Union by size keeps every tree at most log2(n) deep, so no chain of unions can
+    // get deep. Merging equal-sized sets round by round builds the deepest trees it
+    // allows; every round halves the set count and doubles the set sizes.
+    const int n = 1 << 20;
+    UnionFind uf(n);
+    for (int step = 1; step < n; step *= 2) {
+        int merged = 0;
+        for (int i = 0; i < n; i += 2 * step) {
+            if (uf.unite(i + step, i))
+                ++merged;
+        }
+        CHECK(merged == n / (2 * step));
+        CHECK(uf.numSets() == n / (2 * step));
+        CHECK(uf.setSize(n - 1) == 2 * step);
+    }
+    CHECK(uf.setSize(0) == n);
+    CHECK(uf.find(0) == uf.find(n - 1));
+}
+
 TEST_CASE("Priority Queue Extract Min from Empty Queue") {
     PriorityQueue pq(5);
     CHECK_THROWS_AS(pq.extractMin(), std::out_of_range);
@@ -236,6 +279,50 @@ TEST_CASE("Priority Queue Full") {
     CHECK_THROWS_AS(pq.insert(6, 30), std::overflow_error);
 }
 
+TEST_CASE("Priority Queue Extracts In Sorted Order") {
+    PriorityQueue pq(10);
+    int priorities[10] = {7, 3, 9, 1, 8, 2, 6, 0, 5, 4};
+    for (int i = 0; i < 10; ++i) {
+        pq.insert(i, priorities[i]);
+    }
+    pq.decreasePriority(2, -1); // 9 -> -1, moves to the root
+    CHECK(pq.extractMin() == 2);
+    int last = -1;
+    while (!pq.isEmpty()) {
+        int idx = pq.extractMin();
+        CHECK(priorities[idx] >= last);
+        last = priorities[idx];
+        CHECK(!pq.contains(idx));
+    }
+}
+
+TEST_CASE("Priority Queue Index Larger Than Capacity") {
+    PriorityQueue pq(2);
+    pq.insert(1000, 4);
+    pq.insert(7, 2);
+    CHECK(pq.contains(1000));
+    CHECK(!pq.contains(999));
+    CHECK_THROWS_AS(pq.insert(-1, 0), std::overflow_error);
+    CHECK(pq.extractMin() == 7);
+    CHECK_THROWS_AS(pq.insert(-1, 0), std::invalid_argument);
+    CHECK(pq.extractMin() == 1000);
+}
+
+TEST_CASE("Priority Queue Clear") {
+    PriorityQueue pq(4);
+    pq.insert(3, 5);
+    pq.insert(0, 1);
+    pq.insert(2, 3);
+    pq.clear();
+    CHECK(pq.isEmpty());
+    CHECK(!pq.contains(0));
+    CHECK(!pq.contains(3));
+    pq.insert(3, 2);
+    pq.insert(1, 4);
+    CHECK(pq.extractMin() == 3);
+    CHECK(pq.extractMin() == 1);
+}
+
 TEST_CASE("Queue Enqueue and Dequeue") {
     Queue q(5);
     q.enqueue(1);
@@ -444,3 +531,1486 @@ TEST_CASE("Stress test for all algorithms") {
 }
 
 
+
+TEST_CASE("CSRGraph mirrors the adjacency lists") {
+    Graph g(4);
+    g.addEdge(0, 1, 3);
+    g.addEdge(0, 2, 5);
+    g.addEdge(2, 3, 7);
+
+    CSRGraph csr(g);
+    CHECK(csr.getNumVertices() == 4);
+    CHECK(csr.getNumEdges() == 3);
+    CHECK(csr.degree(0) == 2);
+    CHECK(csr.degree(3) == 1);
+    CHECK_THROWS_AS(csr.degree(4), std::out_of_range);
+
+    for (int u = 0; u < 4; ++u) {
+        int pos = csr.getOffset(u);
+        for (Node* curr = g.getAdjList(u); curr != nullptr; curr = curr->next) {
+            CHECK(csr.getNeighbor(pos) == curr->vertex);
+            CHECK(csr.getWeight(pos) == curr->weight);
+            ++pos;
+        }
+        CHECK(pos == csr.getOffset(u + 1));
+    }
+}
+
+TEST_CASE("Algorithms on CSRGraph match the linked-list Graph") {
+    Graph g(7);
+    g.addEdge(0, 1, 2);
+    g.addEdge(0, 2, 4);
+    g.addEdge(1, 3, 7);
+    g.addEdge(1, 4, 1);
+    g.addEdge(2, 5, 3);
+    g.addEdge(3, 5, 1);
+    g.addEdge(4, 6, 5);
+    g.addEdge(5, 6, 2);
+    CSRGraph csr(g);
+
+    Graph listTrees[5] = {Algorithms::bfs(g, 1), Algorithms::dfs(g, 1), Algorithms::dijkstra(g, 1),
+                          Algorithms::prim(g), Algorithms::kruskal(g)};
+    Graph csrTrees[5] = {Algorithms::bfs(csr, 1), Algorithms::dfs(csr, 1), Algorithms::dijkstra(csr, 1),
+                         Algorithms::prim(csr), Algorithms::kruskal(csr)};
+
+    for (int t = 0; t < 5; ++t) {
+        CHECK(listTrees[t].getVisitCount() == csrTrees[t].getVisitCount());
+        for (int i = 0; i < listTrees[t].getVisitCount(); ++i) {
+            CHECK(listTrees[t].getVisitOrderAt(i) == csrTrees[t].getVisitOrderAt(i));
+        }
+        for (int u = 0; u < 7; ++u) {
+            Node* a = listTrees[t].getAdjList(u);
+            Node* b = csrTrees[t].getAdjList(u);
+            while (a != nullptr && b != nullptr) {
+                CHECK(a->vertex == b->vertex);
+                CHECK(a->weight == b->weight);
+                a = a->next;
+                b = b->next;
+            }
+            CHECK(a == b);
+        }
+    }
+
+    CHECK_THROWS_AS(Algorithms::bfs(csr, 7), std::out_of_range);
+}
+
+TEST_CASE("Graph reuses nodes freed by removeEdge") {
+    Graph g(3);
+    g.addEdge(0, 1, 1);
+    Node* n0 = g.getAdjList(0);
+    Node* n1 = g.getAdjList(1);
+    g.removeEdge(0, 1);
+    CHECK(g.getAdjList(0) == nullptr);
+
+    g.addEdge(1, 2, 4);
+    // Both released nodes come back from the free list
+    CHECK(((g.getAdjList(1) == n0 && g.getAdjList(2) == n1) ||
+           (g.getAdjList(1) == n1 && g.getAdjList(2) == n0)));
+    CHECK(g.getAdjList(1)->vertex == 2);
+    CHECK(g.getAdjList(2)->weight == 4);
+}
+
+TEST_CASE("Graph assignment replaces all edges") {
+    Graph g1(200);
+    for (int i = 1; i < 200; ++i) {
+        g1.addEdge(0, i, i);
+    }
+    Graph g2(2);
+    g2.addEdge(0, 1, 9);
+    g2 = g1;
+    g1.removeEdge(0, 5);
+
+    int count = 0;
+    for (Node* curr = g2.getAdjList(0); curr != nullptr; curr = curr->next) {
+        ++count;
+    }
+    CHECK(g2.getNumVertices() == 200);
+    CHECK(count == 199);
+    CHECK(g2.getAdjList(5)->vertex == 0);
+}
+
+TEST_CASE("Graph move constructor and move assignment steal the edges") {
+    Graph g1(3);
+    g1.addEdge(0, 1, 1);
+    g1.addEdge(1, 2, 2);
+    Node* head = g1.getAdjList(1);
+
+    Graph g2(std::move(g1));
+    CHECK(g2.getNumVertices() == 3);
+    CHECK(g2.getAdjList(1) == head); // No copy was made
+    CHECK(g1.getNumVertices() == 0);
+
+    Graph g3(5);
+    g3.addEdge(3, 4, 7);
+    g3 = std::move(g2);
+    CHECK(g3.getNumVertices() == 3);
+    CHECK(g3.getAdjList(1) == head);
+    CHECK(g2.getNumVertices() == 0);
+
+    // A moved-from graph can be assigned again
+    g2 = g3;
+    CHECK(g2.getNumVertices() == 3);
+    CHECK(g2.getAdjList(1) != head);
+
+    Graph tree = Algorithms::bfs(g3, 0);
+    CHECK(tree.getVisitCount() == 3);
+}
+
+TEST_CASE("EdgeMap insert, find and erase") {
+    EdgeMap map;
+    Node* nodes[1000];
+    for (int i = 0; i < 1000; ++i) {
+        nodes[i] = new Node(i, 0);
+        map.insert(i * 7, nodes[i]);
+    }
+    CHECK(map.getSize() == 1000);
+    CHECK_THROWS_AS(map.insert(14, nodes[0]), std::invalid_argument);
+    CHECK_THROWS_AS(map.insert(-3, nodes[0]), std::invalid_argument);
+
+    // Erase every other key, the remaining ones must still be reachable
+    for (int i = 0; i < 1000; i += 2) {
+        CHECK(map.erase(i * 7));
+    }
+    CHECK(!map.erase(0));
+    CHECK(map.getSize() == 500);
+    for (int i = 0; i < 1000; ++i) {
+        if (i % 2 == 0) {
+            CHECK(map.find(i * 7) == nullptr);
+        } else {
+            CHECK(map.find(i * 7) == nodes[i]);
+        }
+    }
+
+    for (int i = 0; i < 1000; ++i) {
+        delete nodes[i];
+    }
+
+    // Capacity growth beyond 2^30 slots throws instead of overflowing int
+    CHECK_THROWS_AS(map.reserve(1 << 30), std::length_error);
+    CHECK(map.getSize() == 500);
+}
+
+TEST_CASE("Graph hub vertex add and remove edges") {
+    Graph g(2000);
+    for (int i = 1; i < 2000; ++i) {
+        g.addEdge(0, i, i);
+    }
+    CHECK_THROWS_AS(g.addEdge(1500, 0, 1), std::invalid_argument);
+
+    for (int i = 1; i < 2000; i += 2) {
+        g.removeEdge(i, 0);
+    }
+    CHECK_THROWS_AS(g.removeEdge(0, 1), std::invalid_argument);
+    CHECK_NOTHROW(g.addEdge(0, 1, 5));
+
+    // The remaining list keeps its order and prev links
+    int count = 0;
+    Node* prev = nullptr;
+    for (Node* curr = g.getAdjList(0); curr != nullptr; curr = curr->next) {
+        CHECK(curr->prev == prev);
+        CHECK((curr->vertex % 2 == 0 || curr->vertex == 1));
+        prev = curr;
+        ++count;
+    }
+    CHECK(count == 1000);
+    CHECK(g.getAdjList(1999) == nullptr);
+}
+
+TEST_CASE("Graph bulk construction from an edge array") {
+    Edge edges[6] = {{0, 1, 1}, {0, 4, 4}, {1, 2, 2}, {3, 1, 5}, {2, 3, 1}, {3, 4, 3}};
+    Graph g(5, edges, 6);
+
+    // Lists are sorted by neighbor and linked both ways
+    int expected[5][3] = {{1, 4, -1}, {0, 2, 3}, {1, 3, -1}, {1, 2, 4}, {0, 3, -1}};
+    for (int u = 0; u < 5; ++u) {
+        int i = 0;
+        Node* prev = nullptr;
+        for (Node* curr = g.getAdjList(u); curr != nullptr; curr = curr->next) {
+            CHECK(curr->vertex == expected[u][i++]);
+            CHECK(curr->prev == prev);
+            prev = curr;
+        }
+        CHECK((i == 3 || expected[u][i] == -1));
+    }
+    CHECK(g.getAdjList(3)->weight == 5);
+
+    // The bulk graph behaves like one built with addEdge
+    CHECK_THROWS_AS(g.addEdge(2, 1, 7), std::invalid_argument);
+    g.removeEdge(1, 3);
+    g.addEdge(0, 2, 6);
+    Graph mst = Algorithms::kruskal(g);
+    int totalWeight = 0;
+    for (int u = 0; u < 5; ++u) {
+        for (Node* curr = mst.getAdjList(u); curr != nullptr; curr = curr->next) {
+            totalWeight += curr->weight;
+        }
+    }
+    CHECK(totalWeight / 2 == 7);
+}
+
+TEST_CASE("Graph bulk construction validation") {
+    Edge outOfRange[2] = {{0, 1, 1}, {1, 3, 1}};
+    Edge selfLoop[2] = {{0, 1, 1}, {2, 2, 1}};
+    Edge duplicate[3] = {{0, 1, 1}, {1, 2, 1}, {1, 0, 8}};
+    CHECK_THROWS_AS(Graph(3, outOfRange, 2), std::out_of_range);
+    CHECK_THROWS_AS(Graph(3, selfLoop, 2), std::invalid_argument);
+    CHECK_THROWS_AS(Graph(3, duplicate, 3), std::invalid_argument);
+    CHECK_THROWS_AS(Graph(0, duplicate, 0), std::invalid_argument);
+    CHECK_THROWS_AS(Graph(3, nullptr, 2), std::invalid_argument);
+    // Just above the largest edge count the edge index can hold, rejected before any edge is read
+    CHECK_THROWS_AS(Graph(3, duplicate, (1 << 28) + 1), std::invalid_argument);
+
+    Graph empty(3, nullptr, 0);
+    CHECK(empty.getAdjList(0) == nullptr);
+}
+
+TEST_CASE("CSRGraph snapshot save and mmap load") {
+    Graph g(5);
+    g.addEdge(0, 1, 1);
+    g.addEdge(0, 4, 4);
+    g.addEdge(1, 2, 2);
+    g.addEdge(1, 3, 5);
+    g.addEdge(2, 3, 1);
+    g.addEdge(3, 4, 3);
+    CSRGraph csr(g);
+    csr.save("test_snapshot.bin");
+
+    {
+        CSRGraph mapped(std::string("test_snapshot.bin"));
+        CHECK(mapped.isMapped());
+        CHECK(!csr.isMapped());
+        CHECK(mapped.getNumVertices() == 5);
+        CHECK(mapped.getNumEntries() == csr.getNumEntries());
+        for (int v = 0; v <= 5; ++v) {
+            CHECK(mapped.getOffset(v) == csr.getOffset(v));
+        }
+        for (int i = 0; i < csr.getNumEntries(); ++i) {
+            CHECK(mapped.getNeighbor(i) == csr.getNeighbor(i));
+            CHECK(mapped.getWeight(i) == csr.getWeight(i));
+        }
+
+        Graph mst = Algorithms::prim(mapped);
+        int totalWeight = 0;
+        for (int u = 0; u < 5; ++u) {
+            for (Node* curr = mst.getAdjList(u); curr != nullptr; curr = curr->next) {
+                totalWeight += curr->weight;
+            }
+        }
+        CHECK(totalWeight / 2 == 7);
+
+        // Copies of a mapped graph own their arrays
+        CSRGraph copy = mapped;
+        CHECK(!copy.isMapped());
+        CHECK(copy.getNeighbor(0) == csr.getNeighbor(0));
+    }
+
+    // Corrupt rows are rejected: a neighbor out of range, then decreasing offsets
+    // (header of 32 bytes, then 6 offsets, then the neighbors)
+    int bad = 9;
+    {
+        std::fstream file("test_snapshot.bin", std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(32 + 6 * 4 + 3 * 4);
+        file.write(reinterpret_cast<const char*>(&bad), sizeof(bad));
+    }
+    CHECK_THROWS_AS(CSRGraph(std::string("test_snapshot.bin")), std::runtime_error);
+    csr.save("test_snapshot.bin");
+    {
+        std::fstream file("test_snapshot.bin", std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(32 + 2 * 4);
+        file.write(reinterpret_cast<const char*>(&bad), sizeof(bad));
+    }
+    CHECK_THROWS_AS(CSRGraph(std::string("test_snapshot.bin")), std::runtime_error);
+
+    std::remove("test_snapshot.bin");
+    CHECK_THROWS_AS(CSRGraph(std::string("test_snapshot.bin")), std::runtime_error);
+}
+
+TEST_CASE("DFS on a long path does not overflow the stack") {
+    const int n = 300000;
+    Edge* edges = new Edge[n - 1];
+    for (int i = 0; i < n - 1; ++i) {
+        edges[i] = {i, i + 1, 1};
+    }
+    Graph g(n, edges, n - 1);
+    delete[] edges;
+
+    Graph tree = Algorithms::dfs(g, 0);
+    CHECK(tree.getVisitCount() == n);
+    bool inOrder = true;
+    for (int i = 0; i < n; ++i) {
+        inOrder = inOrder && tree.getVisitOrderAt(i) == i;
+    }
+    CHECK(inOrder);
+    CHECK(tree.getAdjList(n - 1)->vertex == n - 2);
+}
+
+TEST_CASE("DFS visit order matches the recursive definition") {
+    Graph g(6);
+    g.addEdge(0, 1, 1);
+    g.addEdge(0, 2, 1);
+    g.addEdge(1, 3, 1);
+    g.addEdge(2, 3, 1);
+    g.addEdge(4, 5, 1);
+    // Lists are newest-first: 0:[2,1] 1:[3,0] 2:[3,0] 3:[2,1] 4:[5] 5:[4]
+    Graph tree = Algorithms::dfs(g, 0);
+    int expected[6] = {0, 2, 3, 1, 4, 5};
+    CHECK(tree.getVisitCount() == 6);
+    for (int i = 0; i < 6; ++i) {
+        CHECK(tree.getVisitOrderAt(i) == expected[i]);
+    }
+}
+
+TEST_CASE("TraversalResult overloads report parents, distances and order") {
+    Graph g(6);
+    g.addEdge(0, 1, 1);
+    g.addEdge(0, 4, 4);
+    g.addEdge(1, 2, 2);
+    g.addEdge(1, 3, 5);
+    g.addEdge(2, 3, 1);
+    g.addEdge(3, 4, 3);
+
+    TraversalResult r;
+    Algorithms::bfs(g, 0, r);
+    int hops[6] = {0, 1, 2, 2, 1, -1};
+    for (int v = 0; v < 6; ++v) {
+        CHECK(r.distance[v] == hops[v]);
+    }
+    CHECK(r.orderCount == 5);
+    CHECK(r.order[0] == 0);
+    CHECK(r.parent[5] == -1);
+
+    // The same result object is reused for the next query
+    int* buffer = r.parent;
+    Algorithms::dijkstra(g, 0, r);
+    CHECK(r.parent == buffer);
+    int dist[5] = {0, 1, 3, 4, 4};
+    for (int v = 0; v < 5; ++v) {
+        CHECK(r.distance[v] == dist[v]);
+    }
+    CHECK(r.distance[5] == INT_MAX);
+    CHECK(r.parent[3] == 2);
+    CHECK(r.weight[3] == 1);
+    CHECK(r.order[0] == 0);
+
+    Algorithms::kruskal(g, r);
+    int totalWeight = 0;
+    int roots = 0;
+    for (int i = 0; i < r.orderCount; ++i) {
+        int v = r.order[i];
+        if (r.parent[v] == -1) {
+            ++roots;
+        } else {
+            totalWeight += r.weight[v];
+        }
+    }
+    CHECK(roots == 1);
+    CHECK(r.orderCount == 5);
+    CHECK(totalWeight == 7);
+
+    Algorithms::dfs(g, 0, r);
+    CHECK(r.orderCount == 6);
+    CHECK(r.distance[5] == 0); // Root of its own DFS tree
+}
+
+TEST_CASE("TraversalResult toGraph matches the tree overloads") {
+    Graph g(7);
+    g.addEdge(0, 1, 2);
+    g.addEdge(0, 2, 4);
+    g.addEdge(1, 3, 7);
+    g.addEdge(1, 4, 1);
+    g.addEdge(2, 5, 3);
+    g.addEdge(3, 5, 1);
+    g.addEdge(4, 6, 5);
+    g.addEdge(5, 6, 2);
+
+    TraversalResult r;
+    Algorithms::prim(g, r);
+    Graph fromResult = r.toGraph();
+    Graph tree = Algorithms::prim(g);
+    CHECK(fromResult.getVisitCount() == tree.getVisitCount());
+    for (int i = 0; i < tree.getVisitCount(); ++i) {
+        CHECK(fromResult.getVisitOrderAt(i) == tree.getVisitOrderAt(i));
+    }
+    for (int v = 0; v < 7; ++v) {
+        if (r.parent[v] != -1) {
+            bool found = false;
+            for (Node* curr = tree.getAdjList(v); curr != nullptr; curr = curr->next) {
+                found = found || (curr->vertex == r.parent[v] && curr->weight == r.weight[v]);
+            }
+            CHECK(found);
+        }
+    }
+
+    TraversalResult copy = r;
+    CHECK(copy.parent != r.parent);
+    CHECK(copy.orderCount == r.orderCount);
+    TraversalResult moved = std::move(copy);
+    CHECK(copy.parent == nullptr);
+    CHECK(moved.order[0] == 0);
+    CHECK_THROWS_AS(copy.toGraph(), std::logic_error);
+}
+
+struct CountingObserver : public AlgorithmObserver {
+    int relaxed = 0;
+    int settled = 0;
+    int treeEdges = 0;
+    int treeWeight = 0;
+
+    void edgeRelaxed(int, int, int) override { ++relaxed; }
+    void vertexSettled(int) override { ++settled; }
+    void treeEdgeAdded(int, int, int weight) override {
+        ++treeEdges;
+        treeWeight += weight;
+    }
+};
+
+TEST_CASE("Algorithm observer receives search events") {
+    Graph g(6);
+    g.addEdge(0, 1, 1);
+    g.addEdge(0, 4, 4);
+    g.addEdge(1, 2, 2);
+    g.addEdge(1, 3, 5);
+    g.addEdge(2, 3, 1);
+    g.addEdge(3, 4, 3);
+
+    CountingObserver dij;
+    Algorithms::dijkstra(g, 0, &dij);
+    CHECK(dij.settled == 5);
+    CHECK(dij.treeEdges == 4);
+    CHECK(dij.relaxed >= 4);
+
+    CountingObserver mst;
+    TraversalResult r;
+    Algorithms::kruskal(CSRGraph(g), r, &mst);
+    CHECK(mst.treeEdges == 4);
+    CHECK(mst.treeWeight == 7);
+
+    CountingObserver dfs;
+    Algorithms::dfs(g, 0, r, &dfs);
+    CHECK(dfs.settled == 6);
+    CHECK(dfs.treeEdges == 4);
+
+    CountingObserver bfs;
+    Algorithms::bfs(g, 0, r, &bfs);
+    CHECK(bfs.settled == 5);
+    CHECK(bfs.treeEdges == 4);
+
+    CountingObserver prim;
+    Algorithms::prim(g, r, &prim);
+    CHECK(prim.treeWeight == 7);
+
+    // Without an observer nothing is reported and the result is the same
+    TraversalResult plain;
+    Algorithms::prim(g, plain);
+    CHECK(plain.orderCount == r.orderCount);
+}
+
+// Sum of the edge weights of an undirected graph (each edge counted once)
+static long long totalEdgeWeight(const Graph& g) {
+    long long total = 0;
+    for (int u = 0; u < g.getNumVertices(); ++u) {
+        for (Node* curr = g.getAdjList(u); curr != nullptr; curr = curr->next) {
+            total += curr->weight;
+        }
+    }
+    return total / 2;
+}
+
+// Connected pseudo-random graph: a spanning path plus extra random edges
+static Graph randomConnectedGraph(int n, int extraEdges, unsigned int seed, int maxWeight = 1000) {
+    Graph g(n);
+    for (int i = 0; i < n - 1; ++i) {
+        seed = seed * 1103515245u + 12345u;
+        g.addEdge(i, i + 1, static_cast<int>((seed >> 8) % maxWeight));
+    }
+    for (int i = 0; i < extraEdges; ++i) {
+        seed = seed * 1103515245u + 12345u;
+        int u = static_cast<int>((seed >> 8) % n);
+        seed = seed * 1103515245u + 12345u;
+        int v = static_cast<int>((seed >> 8) % n);
+        seed = seed * 1103515245u + 12345u;
+        int w = static_cast<int>((seed >> 8) % maxWeight);
+        if (u != v) {
+            try {
+                g.addEdge(u, v, w);
+            } catch (const std::invalid_argument&) {
+                // Duplicate edge, skip it
+            }
+        }
+    }
+    return g;
+}
+
+TEST_CASE("Kruskal on a large sparse graph matches Prim") {
+    // n * n would overflow an int here, the edge buffers must follow the real edge count
+    Graph g = randomConnectedGraph(60000, 120000, 7);
+    Graph kruskalTree = Algorithms::kruskal(g);
+    Graph primTree = Algorithms::prim(g);
+    CHECK(totalEdgeWeight(kruskalTree) == totalEdgeWeight(primTree));
+
+    TraversalResult r;
+    Algorithms::kruskal(g, r);
+    CHECK(r.orderCount == 60000);
+}
+
+TEST_CASE("Edge sorts are stable and agree, including negative weights") {
+    Edge a[8] = {{0, 1, 5}, {1, 2, -3}, {2, 3, 5}, {3, 4, 0}, {4, 5, -70000}, {5, 6, 300}, {6, 7, -3}, {7, 0, 65536}};
+    Edge b[8];
+    for (int i = 0; i < 8; ++i) {
+        b[i] = a[i];
+    }
+    Algorithms::sortEdgesByWeight(a, 8, ComparisonSort);
+    Algorithms::sortEdgesByWeight(b, 8, RadixSort);
+    int expectedFrom[8] = {4, 1, 6, 3, 0, 2, 5, 7};
+    for (int i = 0; i < 8; ++i) {
+        CHECK(a[i].from == expectedFrom[i]);
+        CHECK(b[i].from == expectedFrom[i]);
+    }
+}
+
+TEST_CASE("Kruskal radix mode returns the same tree as comparison mode") {
+    Graph g = randomConnectedGraph(3000, 9000, 11, 1 << 20);
+    TraversalResult merge;
+    TraversalResult radix;
+    Algorithms::kruskal(g, ComparisonSort, merge);
+    Algorithms::kruskal(g, RadixSort, radix);
+    CHECK(merge.orderCount == radix.orderCount);
+    bool same = true;
+    for (int v = 0; v < 3000; ++v) {
+        same = same && merge.parent[v] == radix.parent[v] && merge.weight[v] == radix.weight[v];
+    }
+    CHECK(same);
+    CHECK(totalEdgeWeight(Algorithms::kruskal(CSRGraph(g), RadixSort)) == totalEdgeWeight(Algorithms::prim(g)));
+}
+
+TEST_CASE("Filter-Kruskal matches Kruskal") {
+    Graph small(5);
+    small.addEdge(0, 1, 1);
+    small.addEdge(0, 4, 4);
+    small.addEdge(1, 2, 2);
+    small.addEdge(1, 3, 5);
+    small.addEdge(2, 3, 1);
+    small.addEdge(3, 4, 3);
+    CHECK(totalEdgeWeight(Algorithms::filterKruskal(small)) == 7);
+
+    // Dense enough to go through several partition and filter rounds
+    Graph g = randomConnectedGraph(2000, 40000, 3);
+    TraversalResult r;
+    Algorithms::filterKruskal(CSRGraph(g), r);
+    CHECK(r.orderCount == 2000);
+    CHECK(totalEdgeWeight(r.toGraph()) == totalEdgeWeight(Algorithms::kruskal(g)));
+
+    // All weights equal: the equal band of the partition holds every edge
+    Graph flat = randomConnectedGraph(1000, 5000, 5, 1);
+    CHECK(totalEdgeWeight(Algorithms::filterKruskal(flat)) == 0);
+
+    // Disconnected graph gives a forest
+    Graph forest(6);
+    forest.addEdge(0, 1, 2);
+    forest.addEdge(2, 3, 4);
+    forest.addEdge(3, 4, 1);
+    forest.addEdge(2, 4, 7);
+    CHECK(totalEdgeWeight(Algorithms::filterKruskal(forest)) == 7);
+}
+
+TEST_CASE("Parallel Boruvka matches Kruskal") {
+    Graph small(5);
+    small.addEdge(0, 1, 1);
+    small.addEdge(0, 4, 4);
+    small.addEdge(1, 2, 2);
+    small.addEdge(1, 3, 5);
+    small.addEdge(2, 3, 1);
+    small.addEdge(3, 4, 3);
+    CHECK(totalEdgeWeight(Algorithms::boruvka(small, 2)) == 7);
+
+    Graph g = randomConnectedGraph(5000, 20000, 17, 50); // Many equal weights
+    CSRGraph csr(g);
+    long long expected = totalEdgeWeight(Algorithms::kruskal(g));
+    for (int threads = 1; threads <= 4; ++threads) {
+        TraversalResult r;
+        Algorithms::boruvka(csr, threads, r);
+        CHECK(r.orderCount == 5000);
+        CHECK(totalEdgeWeight(r.toGraph()) == expected);
+    }
+
+    Graph forest(6);
+    forest.addEdge(0, 1, 2);
+    forest.addEdge(2, 3, 4);
+    forest.addEdge(3, 4, 1);
+    forest.addEdge(2, 4, 7);
+    CHECK(totalEdgeWeight(Algorithms::boruvka(forest)) == 7);
+    CHECK(Algorithms::boruvka(Graph(1)).getNumVertices() == 1);
+}
+
+TEST_CASE("Concurrent Union Find basic operations") {
+    ConcurrentUnionFind uf(6);
+    CHECK(uf.unite(0, 1));
+    CHECK(uf.unite(2, 3));
+    CHECK(!uf.unite(1, 0));
+    CHECK(uf.sameSet(0, 1));
+    CHECK(!uf.sameSet(1, 2));
+    CHECK(uf.unite(1, 3));
+    CHECK(uf.find(0) == uf.find(2));
+    CHECK(uf.find(4) == 4);
+    CHECK_THROWS_AS(uf.find(6), std::out_of_range);
+    CHECK_THROWS_AS(ConcurrentUnionFind(0), std::invalid_argument);
+}
+
+TEST_CASE("Concurrent Union Find shared between threads") {
+    const int n = 20000;
+    ConcurrentUnionFind uf(n);
+    // Four threads unite overlapping chains, every element ends up in one set
+    std::thread workers[4];
+    std::atomic<int> merges(0);
+    for (int t = 0; t < 4; ++t) {
+        workers[t] = std::thread([&, t]() {
+            for (int i = t; i + 1 < n; i += 2) {
+                if (uf.unite(i, i + 1))
+                    ++merges;
+            }
+        });
+    }
+    for (int t = 0; t < 4; ++t) {
+        workers[t].join();
+    }
+    CHECK(merges.load() == n - 1);
+    int root = uf.find(0);
+    bool allSame = true;
+    for (int i = 0; i < n; ++i) {
+        allSame = allSame && uf.find(i) == root;
+    }
+    CHECK(allSame);
+}
+
+TEST_CASE("Parallel connected components") {
+    Graph g(8);
+    g.addEdge(0, 3, 1);
+    g.addEdge(3, 5, 1);
+    g.addEdge(1, 2, 1);
+    g.addEdge(6, 7, 1);
+    int label[8];
+    CHECK(Algorithms::connectedComponents(g, label, 3) == 4);
+    int expected[8] = {0, 1, 1, 0, 2, 0, 3, 3};
+    for (int v = 0; v < 8; ++v) {
+        CHECK(label[v] == expected[v]);
+    }
+
+    // Below the connectivity threshold: thousands of components of very different sizes
+    const int n = 20000;
+    Graph big(n);
+    unsigned int seed = 23;
+    for (int i = 0; i < 9000; ++i) {
+        seed = seed * 1103515245u + 12345u;
+        int u = static_cast<int>((seed >> 8) % n);
+        seed = seed * 1103515245u + 12345u;
+        int v = static_cast<int>((seed >> 8) % n);
+        if (u != v && big.findEdge(u, v) == nullptr)
+            big.addEdge(u, v, 1);
+    }
+    CSRGraph csr(big);
+
+    // Sequential BFS labeling, components numbered by their smallest vertex
+    int* expectedLabels = new int[n];
+    int* queue = new int[n];
+    for (int v = 0; v < n; ++v) {
+        expectedLabels[v] = -1;
+    }
+    int expectedCount = 0;
+    for (int s = 0; s < n; ++s) {
+        if (expectedLabels[s] != -1)
+            continue;
+        int head = 0;
+        int tail = 0;
+        queue[tail++] = s;
+        expectedLabels[s] = expectedCount;
+        while (head < tail) {
+            int u = queue[head++];
+            for (int i = csr.getOffset(u); i < csr.getOffset(u + 1); ++i) {
+                int w = csr.getNeighbor(i);
+                if (expectedLabels[w] == -1) {
+                    expectedLabels[w] = expectedCount;
+                    queue[tail++] = w;
+                }
+            }
+        }
+        ++expectedCount;
+    }
+
+    int* labels = new int[n];
+    for (int threads = 1; threads <= 4; threads *= 2) {
+        int count = Algorithms::connectedComponents(csr, labels, threads);
+        CHECK(count == expectedCount);
+        int mismatches = 0;
+        for (int v = 0; v < n; ++v) {
+            if (labels[v] != expectedLabels[v])
+                ++mismatches;
+        }
+        CHECK(mismatches == 0);
+    }
+    CHECK(expectedCount > 1000);
+    delete[] labels;
+    delete[] queue;
+    delete[] expectedLabels;
+}
+
+TEST_CASE("Rollback Union Find snapshot and rollback") {
+    RollbackUnionFind uf(6);
+    CHECK(uf.unite(0, 1));
+    int mark = uf.snapshot();
+    CHECK(uf.unite(2, 3));
+    CHECK(uf.unite(1, 3));
+    CHECK(!uf.unite(0, 2));
+    CHECK(uf.setSize(2) == 4);
+    CHECK(uf.numSets() == 3);
+
+    uf.rollback(mark);
+    CHECK(uf.find(0) == uf.find(1));
+    CHECK(uf.find(2) != uf.find(3));
+    CHECK(uf.find(1) != uf.find(3));
+    CHECK(uf.setSize(0) == 2);
+    CHECK(uf.setSize(3) == 1);
+    CHECK(uf.numSets() == 5);
+
+    uf.rollback(0);
+    CHECK(uf.numSets() == 6);
+    CHECK_THROWS_AS(uf.rollback(1), std::invalid_argument);
+    CHECK_THROWS_AS(uf.find(-1), std::out_of_range);
+}
+
+TEST_CASE("Dynamic connectivity answers queries along the timeline") {
+    Graph g(4);
+    g.addEdge(0, 1, 5);
+    ConnectivityEvent events[] = {
+        {ConnectedQuery, 0, 1}, // true, edge of the initial graph
+        {ConnectedQuery, 0, 2}, // false
+        {InsertEdge, 1, 2},
+        {ConnectedQuery, 0, 2}, // true
+        {DeleteEdge, 0, 1},
+        {ConnectedQuery, 0, 2}, // false
+        {ConnectedQuery, 1, 2}, // true
+        {InsertEdge, 0, 1},
+        {InsertEdge, 2, 3},
+        {ConnectedQuery, 3, 0}, // true
+        {ConnectedQuery, 3, 3}  // true
+    };
+    bool answers[7];
+    CHECK(Algorithms::dynamicConnectivity(g, events, 11, answers) == 7);
+    bool expected[7] = {true, false, true, false, true, true, true};
+    for (int i = 0; i < 7; ++i) {
+        CHECK(answers[i] == expected[i]);
+    }
+    // The input graph is only the starting point, it is left unchanged
+    CHECK(g.findEdge(1, 2) == nullptr);
+    CHECK(g.findEdge(0, 1) != nullptr);
+
+    ConnectivityEvent missing[] = {{DeleteEdge, 2, 3}};
+    CHECK_THROWS_AS(Algorithms::dynamicConnectivity(g, missing, 1, answers), std::invalid_argument);
+    ConnectivityEvent twice[] = {{InsertEdge, 1, 0}};
+    CHECK_THROWS_AS(Algorithms::dynamicConnectivity(g, twice, 1, answers), std::invalid_argument);
+    ConnectivityEvent outside[] = {{ConnectedQuery, 0, 4}};
+    CHECK_THROWS_AS(Algorithms::dynamicConnectivity(g, outside, 1, answers), std::out_of_range);
+}
+
+TEST_CASE("Dynamic connectivity matches replaying the timeline") {
+    const int n = 60;
+    const int numEvents = 20000;
+    ConnectivityEvent* events = new ConnectivityEvent[numEvents];
+    bool* expected = new bool[numEvents];
+    bool* answers = new bool[numEvents];
+    int label[n];
+    Graph live(n);
+    unsigned int seed = 99;
+    int numQueries = 0;
+    int trueAnswers = 0;
+
+    // A random pair is deleted when present but only inserted one time in twenty
+    // otherwise (then it is queried instead), which keeps the graph sparse enough
+    // that both answers come up
+    for (int i = 0; i < numEvents; ++i) {
+        seed = seed * 1103515245u + 12345u;
+        int u = static_cast<int>((seed >> 8) % n);
+        seed = seed * 1103515245u + 12345u;
+        int v = static_cast<int>((seed >> 8) % n);
+        seed = seed * 1103515245u + 12345u;
+        bool insert = (seed >> 8) % 20 == 0;
+        if (u != v && live.findEdge(u, v) != nullptr) {
+            events[i] = {DeleteEdge, u, v};
+            live.removeEdge(u, v);
+        } else if (u != v && insert) {
+            events[i] = {InsertEdge, u, v};
+            live.addEdge(u, v, 1);
+        } else {
+            events[i] = {ConnectedQuery, u, v};
+            Algorithms::connectedComponents(live, label, 1);
+            expected[numQueries] = label[u] == label[v];
+            trueAnswers += expected[numQueries] ? 1 : 0;
+            ++numQueries;
+        }
+    }
+    CHECK(trueAnswers > 0);
+    CHECK(trueAnswers < numQueries);
+
+    CHECK(Algorithms::dynamicConnectivity(Graph(n), events, numEvents, answers) == numQueries);
+    int mismatches = 0;
+    for (int q = 0; q < numQueries; ++q) {
+        if (answers[q] != expected[q])
+            ++mismatches;
+    }
+    CHECK(mismatches == 0);
+
+    delete[] events;
+    delete[] expected;
+    delete[] answers;
+}
+
+// True if actual holds the same BFS distances as expected and every parent is a
+// neighbor one level closer to the start, i.e. actual is a valid BFS tree
+static bool sameBfsLevels(const Graph& g, const TraversalResult& expected, const TraversalResult& actual) {
+    if (actual.orderCount != expected.orderCount)
+        return false;
+    for (int v = 0; v < g.getNumVertices(); ++v) {
+        if (actual.distance[v] != expected.distance[v])
+            return false;
+        int p = actual.parent[v];
+        if (p == -1) {
+            if (actual.distance[v] > 0)
+                return false;
+        } else if (g.findEdge(p, v) == nullptr || actual.distance[p] != actual.distance[v] - 1) {
+            return false;
+        }
+    }
+    return true;
+}
+
+TEST_CASE("Direction-optimizing BFS matches top-down BFS") {
+    // Sparse long path-like graph: stays top-down
+    Graph sparse = randomConnectedGraph(5000, 500, 3);
+    // Dense low-diameter graph: the middle levels go bottom-up
+    Graph dense = randomConnectedGraph(3000, 60000, 4);
+    // Two components, the second never reached
+    Graph split(10);
+    split.addEdge(0, 1);
+    split.addEdge(1, 2);
+    split.addEdge(0, 3);
+    split.addEdge(5, 6);
+
+    Graph* graphs[3] = {&sparse, &dense, &split};
+    for (int i = 0; i < 3; ++i) {
+        TraversalResult expected;
+        TraversalResult actual;
+        TraversalResult fromCsr;
+        Algorithms::bfs(*graphs[i], 0, expected);
+        Algorithms::bfs(*graphs[i], 0, DirectionOptimizing, actual);
+        Algorithms::bfs(CSRGraph(*graphs[i]), 0, DirectionOptimizing, fromCsr);
+        CHECK(sameBfsLevels(*graphs[i], expected, actual));
+        CHECK(sameBfsLevels(*graphs[i], expected, fromCsr));
+    }
+
+    CountingObserver counter;
+    Graph tree = Algorithms::bfs(dense, 7, DirectionOptimizing, &counter);
+    CHECK(counter.settled == 3000);
+    CHECK(counter.treeEdges == 2999);
+    CHECK(tree.getNumEntries() == 2 * 2999);
+    CHECK_THROWS_AS(Algorithms::bfs(dense, 3000, DirectionOptimizing), std::out_of_range);
+}
+
+TEST_CASE("Parallel BFS matches BFS levels") {
+    Graph dense = randomConnectedGraph(4000, 40000, 5);
+    Graph sparse = randomConnectedGraph(6000, 600, 6);
+    Graph split(10);
+    split.addEdge(0, 1);
+    split.addEdge(1, 2);
+    split.addEdge(5, 6);
+    // Levels wide enough for the thread team, and a long path that only runs serial levels
+    Graph wide = randomConnectedGraph(60000, 240000, 8);
+    Graph path = randomConnectedGraph(50000, 0, 9);
+
+    Graph* graphs[5] = {&dense, &sparse, &split, &wide, &path};
+    for (int i = 0; i < 5; ++i) {
+        TraversalResult expected;
+        Algorithms::bfs(*graphs[i], 1, expected);
+        for (int threads = 1; threads <= 4; ++threads) {
+            TraversalResult actual;
+            Algorithms::parallelBfs(*graphs[i], 1, threads, actual);
+            CHECK(sameBfsLevels(*graphs[i], expected, actual));
+        }
+        TraversalResult fromCsr;
+        Algorithms::parallelBfs(CSRGraph(*graphs[i]), 1, 3, fromCsr);
+        CHECK(sameBfsLevels(*graphs[i], expected, fromCsr));
+    }
+
+    CountingObserver counter;
+    Graph tree = Algorithms::parallelBfs(dense, 0, 4, &counter);
+    CHECK(counter.settled == 4000);
+    CHECK(counter.treeEdges == 3999);
+    CHECK(tree.getNumEntries() == 2 * 3999);
+    CHECK_THROWS_AS(Algorithms::parallelBfs(dense, -1, 2), std::out_of_range);
+}
+
+TEST_CASE("Multi-source BFS matches one BFS per source") {
+    Graph g = randomConnectedGraph(1500, 1500, 8);
+    g.removeEdge(1000, 1001); // May split off a part that some sources cannot reach
+    const int numSources = 150; // Three batches, the last one partial
+    int sources[numSources];
+    for (int i = 0; i < numSources; ++i) {
+        sources[i] = (i * 37) % 1500;
+    }
+    sources[5] = sources[4]; // Repeated sources in one batch
+
+    int* distances = new int[numSources * 1500];
+    Algorithms::multiSourceBfs(g, sources, numSources, distances);
+    int mismatches = 0;
+    TraversalResult single;
+    for (int i = 0; i < numSources; ++i) {
+        Algorithms::bfs(g, sources[i], single);
+        for (int v = 0; v < 1500; ++v) {
+            if (distances[i * 1500 + v] != single.distance[v])
+                ++mismatches;
+        }
+    }
+    CHECK(mismatches == 0);
+
+    int fromCsr[3 * 1500];
+    Algorithms::multiSourceBfs(CSRGraph(g), sources, 3, fromCsr);
+    bool same = true;
+    for (int i = 0; i < 3 * 1500; ++i) {
+        same = same && fromCsr[i] == distances[i];
+    }
+    CHECK(same);
+
+    int bad[2] = {0, 1500};
+    CHECK_THROWS_AS(Algorithms::multiSourceBfs(g, bad, 2, distances), std::out_of_range);
+    delete[] distances;
+}
+
+TEST_CASE("Multi-source BFS on a long path") {
+    // 100000 levels: a level must cost its frontier, not a sweep over all vertices
+    const int n = 100000;
+    CSRGraph path(randomConnectedGraph(n, 0, 3));
+    int sources[2] = {0, n / 2};
+    int* distances = new int[2 * n];
+    Algorithms::multiSourceBfs(path, sources, 2, distances);
+    int mismatches = 0;
+    for (int v = 0; v < n; ++v) {
+        if (distances[v] != v || distances[n + v] != (v > n / 2 ? v - n / 2 : n / 2 - v))
+            ++mismatches;
+    }
+    CHECK(mismatches == 0);
+    delete[] distances;
+}
+
+TEST_CASE("Delta-stepping matches Dijkstra distances") {
+    // Weights in [0, 100), zero weight edges included
+    Graph g = randomConnectedGraph(3000, 9000, 12, 100);
+    Graph split(6);
+    split.addEdge(0, 1, 4);
+    split.addEdge(1, 2, 1);
+    split.addEdge(0, 2, 7);
+    split.addEdge(3, 4, 2);
+    // Buckets wide enough to be split across the thread team
+    Graph wide = randomConnectedGraph(40000, 200000, 13, 100);
+
+    Graph* graphs[3] = {&g, &split, &wide};
+    for (int k = 0; k < 3; ++k) {
+        const Graph& graph = *graphs[k];
+        TraversalResult expected;
+        Algorithms::dijkstra(graph, 0, expected);
+
+        const int deltas[4] = {1, 7, 60, 1000000};
+        for (int d = 0; d < 4; ++d) {
+            for (int threads = 1; threads <= 4; threads += 3) {
+                TraversalResult actual;
+                Algorithms::deltaStepping(graph, 0, deltas[d], threads, actual);
+                bool sameDistances = actual.orderCount == expected.orderCount;
+                bool validTree = true;
+                for (int v = 0; v < graph.getNumVertices(); ++v) {
+                    sameDistances = sameDistances && actual.distance[v] == expected.distance[v];
+                    int p = actual.parent[v];
+                    if (p != -1) {
+                        Node* edge = graph.findEdge(p, v);
+                        validTree = validTree && edge != nullptr && edge->weight == actual.weight[v] &&
+                                    actual.distance[p] + edge->weight == actual.distance[v];
+                    }
+                    // Following the parents must reach a root, a cycle never does
+                    int steps = 0;
+                    for (int u = v; u != -1 && steps <= graph.getNumVertices(); u = actual.parent[u]) {
+                        ++steps;
+                    }
+                    validTree = validTree && steps <= graph.getNumVertices();
+                }
+                CHECK(sameDistances);
+                CHECK(validTree);
+            }
+        }
+    }
+
+    CountingObserver counter;
+    Graph tree = Algorithms::deltaStepping(CSRGraph(g), 5, 0, 2, &counter);
+    CHECK(counter.settled == 3000);
+    CHECK(counter.treeEdges == 2999);
+    CHECK(totalEdgeWeight(tree) == counter.treeWeight);
+
+    Graph negative(3);
+    negative.addEdge(0, 1, 2);
+    negative.addEdge(1, 2, -1);
+    CHECK_THROWS_AS(Algorithms::deltaStepping(negative, 0), std::invalid_argument);
+    CHECK_THROWS_AS(Algorithms::deltaStepping(negative, 3), std::out_of_range);
+}
+
+// True if result.path is a source - target path in g whose weights add up to result.distance
+static bool validPath(const Graph& g, int source, int target, const PathResult& result) {
+    if (result.pathLength == 0 || result.path[0] != source || result.path[result.pathLength - 1] != target)
+        return false;
+    long long length = 0;
+    for (int i = 0; i + 1 < result.pathLength; ++i) {
+        Node* edge = g.findEdge(result.path[i], result.path[i + 1]);
+        if (edge == nullptr)
+            return false;
+        length += edge->weight;
+    }
+    return length == result.distance;
+}
+
+TEST_CASE("Bidirectional Dijkstra matches Dijkstra distances") {
+    Graph g = randomConnectedGraph(2000, 3000, 14, 100);
+    PathResult result;
+    TraversalResult all;
+    int wrong = 0;
+    for (int source = 0; source < 2000; source += 97) {
+        Algorithms::dijkstra(g, source, all);
+        for (int target = 3; target < 2000; target += 131) {
+            Algorithms::bidirectionalDijkstra(g, source, target, result);
+            if (result.distance != all.distance[target] || !validPath(g, source, target, result))
+                ++wrong;
+        }
+    }
+    CHECK(wrong == 0);
+
+    Algorithms::bidirectionalDijkstra(CSRGraph(g), 10, 1500, result);
+    Algorithms::dijkstra(g, 10, all);
+    CHECK(result.distance == all.distance[1500]);
+    CHECK(validPath(g, 10, 1500, result));
+
+    Algorithms::bidirectionalDijkstra(g, 42, 42, result);
+    CHECK(result.distance == 0);
+    CHECK(result.pathLength == 1);
+}
+
+TEST_CASE("Bidirectional Dijkstra explores only around the path") {
+    // A long path: a nearby pair is found after settling a handful of vertices
+    Graph line = randomConnectedGraph(20000, 0, 15);
+    PathResult result;
+    Algorithms::bidirectionalDijkstra(line, 10000, 10010, result);
+    CHECK(result.pathLength == 11);
+    CHECK(validPath(line, 10000, 10010, result));
+    CHECK(result.settled < 40);
+
+    Graph split(4);
+    split.addEdge(0, 1, 3);
+    split.addEdge(2, 3, 1);
+    Algorithms::bidirectionalDijkstra(split, 0, 3, result);
+    CHECK(result.distance == INT_MAX);
+    CHECK(result.pathLength == 0);
+
+    PathResult copy = result;
+    Algorithms::bidirectionalDijkstra(split, 1, 0, result);
+    CHECK(copy.distance == INT_MAX);
+    CHECK(result.distance == 3);
+    PathResult moved = std::move(result);
+    CHECK(moved.pathLength == 2);
+    CHECK(moved.path[0] == 1);
+    CHECK_THROWS_AS(Algorithms::bidirectionalDijkstra(split, 0, 4, result), std::out_of_range);
+    split.addEdge(1, 2, -1);
+    CHECK_THROWS_AS(Algorithms::bidirectionalDijkstra(split, 0, 3, result), std::invalid_argument);
+
+    // The failed query leaves no labels behind for the next one on the same result
+    split.removeEdge(1, 2);
+    split.addEdge(1, 2, 4);
+    Algorithms::bidirectionalDijkstra(split, 3, 0, result);
+    CHECK(result.distance == 8);
+    CHECK(result.pathLength == 4);
+    Algorithms::bidirectionalDijkstra(line, 10010, 10000, result);
+    CHECK(result.pathLength == 11);
+    CHECK(result.settled < 40);
+}
+
+TEST_CASE("Dijkstra stops at targets and distance bounds") {
+    Graph g = randomConnectedGraph(3000, 6000, 16, 100);
+    TraversalResult full;
+    Algorithms::dijkstra(g, 0, full);
+
+    // Stops right after the last target: it is the last vertex settled
+    int targets[3] = {17, 2500, 17};
+    DijkstraLimits limits;
+    limits.targets = targets;
+    limits.numTargets = 3;
+    TraversalResult partial;
+    Algorithms::dijkstra(g, 0, limits, partial);
+    int last = partial.order[partial.orderCount - 1];
+    CHECK((last == 17 || last == 2500));
+    CHECK(partial.distance[17] == full.distance[17]);
+    CHECK(partial.distance[2500] == full.distance[2500]);
+    CHECK(partial.orderCount < 3000);
+    bool consistent = true;
+    int reached = 0;
+    for (int v = 0; v < 3000; ++v) {
+        if (partial.distance[v] != INT_MAX) {
+            ++reached;
+            consistent = consistent && partial.distance[v] == full.distance[v];
+        } else {
+            consistent = consistent && partial.parent[v] == -1;
+        }
+    }
+    CHECK(consistent);
+    CHECK(reached == partial.orderCount); // Tentative labels were cleared
+
+    // Radius query: exactly the vertices within the bound
+    DijkstraLimits radius;
+    radius.maxDistance = 150;
+    TraversalResult ball;
+    Algorithms::dijkstra(CSRGraph(g), 0, radius, ball);
+    bool exact = true;
+    int inside = 0;
+    for (int v = 0; v < 3000; ++v) {
+        bool within = full.distance[v] <= 150;
+        inside += within ? 1 : 0;
+        exact = exact && (within ? ball.distance[v] == full.distance[v] : ball.distance[v] == INT_MAX);
+    }
+    CHECK(exact);
+    CHECK(ball.orderCount == inside);
+
+    Graph tree = Algorithms::dijkstra(g, 0, radius);
+    CHECK(tree.getNumEntries() == 2 * (inside - 1));
+
+    // A result reused across queries, which only clears what the last one settled,
+    // matches a fresh result, also after a bfs filled it or a query failed
+    Graph negative = g;
+    negative.removeEdge(0, g.getAdjList(0)->vertex);
+    negative.addEdge(0, g.getAdjList(0)->vertex, -1);
+    TraversalResult reused;
+    bool same = true;
+    for (int q = 0; q < 30; ++q) {
+        int source = (q * 97) % 3000;
+        DijkstraLimits near;
+        near.maxDistance = 40 + q;
+        near.targets = targets;
+        near.numTargets = q % 2;
+        TraversalResult fresh;
+        Algorithms::dijkstra(g, source, near, fresh);
+        if (q == 10)
+            Algorithms::bfs(g, source, reused);
+        if (q == 20)
+            CHECK_THROWS_AS(Algorithms::dijkstra(negative, 0, near, reused), std::invalid_argument);
+        Algorithms::dijkstra(g, source, near, reused);
+        same = same && reused.orderCount == fresh.orderCount;
+        for (int v = 0; v < 3000; ++v) {
+            same = same && reused.distance[v] == fresh.distance[v] && reused.parent[v] == fresh.parent[v] &&
+                   reused.weight[v] == fresh.weight[v];
+        }
+    }
+    CHECK(same);
+
+    int bad[1] = {3000};
+    limits.targets = bad;
+    limits.numTargets = 1;
+    CHECK_THROWS_AS(Algorithms::dijkstra(g, 0, limits), std::out_of_range);
+}
+
+// side x side grid with coordinates, vertex r * side + c at (c, r); every edge
+// weighs 10 (its length in tenths) plus a random detour, so 10 * straight-line
+// distance never overestimates
+static Graph gridGraph(int side, unsigned int seed, CoordinateTable& coordinates) {
+    Graph g(side * side);
+    for (int r = 0; r < side; ++r) {
+        for (int c = 0; c < side; ++c) {
+            int v = r * side + c;
+            coordinates.set(v, c, r);
+            seed = seed * 1103515245u + 12345u;
+            if (c + 1 < side)
+                g.addEdge(v, v + 1, 10 + static_cast<int>((seed >> 8) % 5));
+            seed = seed * 1103515245u + 12345u;
+            if (r + 1 < side)
+                g.addEdge(v, v + side, 10 + static_cast<int>((seed >> 8) % 5));
+        }
+    }
+    return g;
+}
+
+struct ZeroHeuristic {
+    int operator()(int) const { return 0; }
+};
+
+TEST_CASE("A* with a Euclidean heuristic matches Dijkstra") {
+    const int side = 60;
+    CoordinateTable coordinates(side * side);
+    Graph g = gridGraph(side, 17, coordinates);
+    CSRGraph csr(g);
+
+    PathResult guided;
+    PathResult blind;
+    TraversalResult all;
+    int wrong = 0;
+    bool fewer = true;
+    const int sources[3] = {0, 1830, 3599};
+    const int targets[3] = {3599, 61, 1200};
+    for (int i = 0; i < 3; ++i) {
+        Algorithms::dijkstra(g, sources[i], all);
+        Algorithms::aStar(g, sources[i], targets[i], EuclideanHeuristic(coordinates, targets[i], 10.0), guided);
+        Algorithms::aStar(csr, sources[i], targets[i], ZeroHeuristic(), blind);
+        if (guided.distance != all.distance[targets[i]] || !validPath(g, sources[i], targets[i], guided))
+            ++wrong;
+        if (blind.distance != all.distance[targets[i]] || !validPath(g, sources[i], targets[i], blind))
+            ++wrong;
+        fewer = fewer && guided.settled < blind.settled;
+    }
+    CHECK(wrong == 0);
+    CHECK(fewer);
+
+    // A lambda works as well, and the coordinate overload uses scale 1
+    int goal = 2000;
+    Algorithms::aStar(g, 5, goal, [&](int v) { return 10 * (std::abs(v % side - goal % side) + std::abs(v / side - goal / side)) / 2; }, guided);
+    Algorithms::dijkstra(g, 5, all);
+    CHECK(guided.distance == all.distance[goal]);
+    Algorithms::aStar(g, 5, goal, coordinates, guided);
+    CHECK(guided.distance == all.distance[goal]);
+    CHECK(validPath(g, 5, goal, guided));
+
+    CHECK_THROWS_AS(Algorithms::aStar(g, 0, 1, CoordinateTable(10), guided), std::invalid_argument);
+    CHECK_THROWS_AS(Algorithms::aStar(g, 0, side * side, ZeroHeuristic(), guided), std::out_of_range);
+
+    // The search state kept in the result is left clear by failed queries, whether
+    // the search throws (negative weight) or the heuristic does, and is shared
+    // with bidirectionalDijkstra
+    Graph negative = g;
+    negative.removeEdge(0, 1);
+    negative.addEdge(0, 1, -5);
+    CHECK_THROWS_AS(Algorithms::aStar(negative, 0, 3599, ZeroHeuristic(), guided), std::invalid_argument);
+    Algorithms::dijkstra(g, 0, all);
+    Algorithms::aStar(g, 0, 3599, ZeroHeuristic(), guided);
+    CHECK(guided.distance == all.distance[3599]);
+    CHECK(validPath(g, 0, 3599, guided));
+    auto failing = [](int v) {
+        if (v == 1200)
+            throw std::runtime_error("heuristic failed");
+        return 0;
+    };
+    CHECK_THROWS_AS(Algorithms::aStar(g, 0, 3599, failing, guided), std::runtime_error);
+    Algorithms::bidirectionalDijkstra(g, 3599, 0, guided);
+    CHECK(guided.distance == all.distance[3599]);
+    CHECK(validPath(g, 3599, 0, guided));
+    Algorithms::aStar(g, 0, 3599, EuclideanHeuristic(coordinates, 3599, 10.0), guided);
+    CHECK(guided.distance == all.distance[3599]);
+    CHECK(validPath(g, 0, 3599, guided));
+}
+
+TEST_CASE("Landmark table distances and lower bounds") {
+    CoordinateTable coordinates(40 * 40);
+    Graph g = gridGraph(40, 21, coordinates);
+    LandmarkTable table(g, 6, 3);
+    CHECK(table.getNumLandmarks() == 6);
+    CHECK(table.getNumVertices() == 1600);
+
+    // Farthest-point selection starts at a corner far from vertex 0 and never repeats
+    CHECK(table.getLandmark(0) == 1599);
+    bool distinct = true;
+    for (int i = 0; i < 6; ++i) {
+        for (int j = 0; j < i; ++j) {
+            distinct = distinct && table.getLandmark(i) != table.getLandmark(j);
+        }
+    }
+    CHECK(distinct);
+
+    TraversalResult all;
+    bool exact = true;
+    for (int i = 0; i < 6; ++i) {
+        Algorithms::dijkstra(g, table.getLandmark(i), all);
+        for (int v = 0; v < 1600; ++v) {
+            exact = exact && table.getDistance(i, v) == all.distance[v];
+        }
+    }
+    CHECK(exact);
+
+    Algorithms::dijkstra(g, 37, all);
+    bool admissible = true;
+    for (int v = 0; v < 1600; ++v) {
+        admissible = admissible && table.lowerBound(v, 37) <= all.distance[v];
+    }
+    CHECK(admissible);
+    CHECK(table.lowerBound(37, 37) == 0);
+
+    int given[2] = {0, 1600};
+    CHECK_THROWS_AS(LandmarkTable(g, given, 2), std::out_of_range);
+    CHECK_THROWS_AS(LandmarkTable(g, 0), std::invalid_argument);
+    CHECK_THROWS_AS(LandmarkTable(g, 1601), std::invalid_argument);
+}
+
+TEST_CASE("ALT queries settle fewer vertices than Dijkstra") {
+    CoordinateTable coordinates(70 * 70);
+    Graph g = gridGraph(70, 22, coordinates);
+    CSRGraph csr(g);
+    LandmarkTable table(csr, 8);
+
+    PathResult alt;
+    PathResult blind;
+    TraversalResult all;
+    int wrong = 0;
+    long long altSettled = 0;
+    long long blindSettled = 0;
+    for (int q = 0; q < 10; ++q) {
+        int source = (q * 487) % 4900;
+        int target = (q * 1319 + 2000) % 4900;
+        Algorithms::dijkstra(g, source, all);
+        Algorithms::aStar(g, source, target, table, alt);
+        Algorithms::aStar(csr, source, target, ZeroHeuristic(), blind);
+        if (alt.distance != all.distance[target] || !validPath(g, source, target, alt))
+            ++wrong;
+        altSettled += alt.settled;
+        blindSettled += blind.settled;
+    }
+    CHECK(wrong == 0);
+    CHECK(altSettled * 2 < blindSettled);
+    CHECK_THROWS_AS(Algorithms::aStar(g, 0, 1, LandmarkTable(Graph(3), 1), alt), std::invalid_argument);
+}
+
+TEST_CASE("Parallel helpers rethrow worker exceptions") {
+    // A worker chunk and the caller's chunk: the other threads are still joined
+    for (int failing = 0; failing < 4; failing += 3) {
+        std::atomic<int> finished(0);
+        CHECK_THROWS_AS(parallelChunks(400, 4,
+                                       [&](int t, int, int) {
+                                           if (t == failing)
+                                               throw std::invalid_argument("chunk failed");
+                                           ++finished;
+                                       }),
+                        std::invalid_argument);
+        CHECK(finished == 3);
+    }
+
+    // A team thread that fails releases the others from the barrier
+    Barrier barrier(4);
+    CHECK_THROWS_AS(parallelTeam(4, barrier,
+                                 [&](int t) {
+                                     barrier.wait();
+                                     if (t == 2)
+                                         throw std::out_of_range("team member failed");
+                                     barrier.wait();
+                                 }),
+                    std::out_of_range);
+
+    // Landmark preprocessing rejects negative weights instead of failing inside a thread
+    Graph line = randomConnectedGraph(2000, 0, 4, 50);
+    line.removeEdge(1000, 1001);
+    line.addEdge(1000, 1001, -1);
+    int chosen[4] = {0, 500, 1500, 1999};
+    CHECK_THROWS_AS(LandmarkTable(line, chosen, 4, 4), std::invalid_argument);
+    CHECK_THROWS_AS(LandmarkTable(CSRGraph(line), 2, 4), std::invalid_argument);
+}
+
+TEST_CASE("Landmark table save and map") {
+    Graph g = randomConnectedGraph(500, 800, 31, 50);
+    Graph isolated(3);
+    isolated.addEdge(0, 1, 4);
+    LandmarkTable table(g, 4);
+    table.save("test_landmarks.bin");
+
+    {
+        LandmarkTable mapped(std::string("test_landmarks.bin"));
+        CHECK(mapped.isMapped());
+        CHECK(mapped.getNumLandmarks() == 4);
+        bool same = true;
+        for (int i = 0; i < 4; ++i) {
+            same = same && mapped.getLandmark(i) == table.getLandmark(i);
+            for (int v = 0; v < 500; ++v) {
+                same = same && mapped.getDistance(i, v) == table.getDistance(i, v);
+            }
+        }
+        CHECK(same);
+
+        PathResult fromMapped;
+        TraversalResult all;
+        Algorithms::aStar(g, 3, 444, mapped, fromMapped);
+        Algorithms::dijkstra(g, 3, all);
+        CHECK(fromMapped.distance == all.distance[444]);
+
+        LandmarkTable copy = mapped;
+        CHECK(!copy.isMapped());
+        CHECK(copy.getDistance(3, 10) == table.getDistance(3, 10));
+
+        // Moves hand over the mapping or the arrays without copying
+        LandmarkTable moved = std::move(mapped);
+        CHECK(moved.isMapped());
+        CHECK(moved.getDistance(3, 10) == table.getDistance(3, 10));
+        CHECK(moved.matches(g));
+        CHECK(mapped.getNumLandmarks() == 0);
+        CHECK(!mapped.isMapped());
+        copy = std::move(moved);
+        CHECK(copy.isMapped());
+        CHECK(copy.getLandmark(2) == table.getLandmark(2));
+        LandmarkTable empty = mapped;
+        CHECK(empty.getNumVertices() == 0);
+    }
+
+    // Separate components: selection reaches the lone vertex, bounds stay admissible
+    LandmarkTable split(isolated, 2);
+    CHECK(split.getLandmark(0) == 2);
+    CHECK(split.getLandmark(1) == 1);
+    CHECK(split.getDistance(1, 2) == LandmarkTable::UNREACHED);
+    CHECK(split.lowerBound(0, 2) == 0);
+
+    // A landmark must be at distance 0 from itself (header of 48 bytes, then the 4 landmarks)
+    int bad = 7;
+    {
+        std::fstream file("test_landmarks.bin", std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(48 + 4 * 4 + 4 * (4 * table.getLandmark(0)));
+        file.write(reinterpret_cast<const char*>(&bad), sizeof(bad));
+    }
+    CHECK_THROWS_AS(LandmarkTable(std::string("test_landmarks.bin")), std::runtime_error);
+
+    std::remove("test_landmarks.bin");
+    CHECK_THROWS_AS(LandmarkTable(std::string("test_landmarks.bin")), std::runtime_error);
+}
+
+TEST_CASE("Landmark tables reject edited graphs") {
+    Graph g = randomConnectedGraph(800, 1500, 41, 60);
+    CSRGraph csr(g);
+    CHECK(g.getEdgeChecksum() == csr.getEdgeChecksum());
+
+    // The checksum depends only on the edge set, not on how it was built
+    Edge edges[3] = {{0, 1, 5}, {2, 1, 7}, {3, 0, 2}};
+    Graph bulk(4, edges, 3);
+    Graph added(4);
+    added.addEdge(1, 2, 7);
+    added.addEdge(0, 3, 2);
+    added.addEdge(1, 0, 5);
+    CHECK(bulk.getEdgeChecksum() == added.getEdgeChecksum());
+    added.removeEdge(0, 3);
+    CHECK(bulk.getEdgeChecksum() != added.getEdgeChecksum());
+    added.addEdge(3, 0, 2);
+    CHECK(bulk.getEdgeChecksum() == added.getEdgeChecksum());
+
+    LandmarkTable table(g, 4);
+    CHECK(table.matches(g));
+    CHECK(table.matches(csr));
+    table.save("test_landmarks.bin");
+    csr.save("test_snapshot.bin");
+    {
+        LandmarkTable mapped(std::string("test_landmarks.bin"));
+        CSRGraph mappedGraph(std::string("test_snapshot.bin"));
+        CHECK(mapped.matches(mappedGraph));
+        CHECK(mapped.matches(g));
+    }
+    std::remove("test_landmarks.bin");
+    std::remove("test_snapshot.bin");
+
+    // Same vertices and entry count, one weight lowered: the old bounds could overestimate
+    Node* edge = g.findEdge(10, 11);
+    int weight = edge->weight;
+    g.removeEdge(10, 11);
+    g.addEdge(10, 11, weight > 0 ? weight - 1 : weight + 1);
+    CHECK(!table.matches(g));
+    PathResult result;
+    CHECK_THROWS_AS(Algorithms::aStar(g, 0, 700, table, result), std::invalid_argument);
+    CHECK_THROWS_AS(Algorithms::aStar(CSRGraph(g), 0, 700, table, result), std::invalid_argument);
+    Algorithms::aStar(csr, 0, 700, table, result);
+    CHECK(result.pathLength > 0);
+}